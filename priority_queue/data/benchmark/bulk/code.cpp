@@ -0,0 +1,64 @@
+// building a priority_queue of n random numbers: n pushes against the O(n)
+// constructor from a sjtu::vector, then push_range of n more into the full queue
+// usage: pq_benchmark_bulk [n], n = 5000000 by default
+#include "../../../src/priority_queue.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+template <class Func>
+long long TimeMilli(Func func) {
+  auto beg = std::chrono::high_resolution_clock::now();
+  func();
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration_cast<std::chrono::milliseconds>(end - beg).count();
+}
+
+unsigned Rand() {
+  static unsigned val = 2463534242u;
+  val ^= val << 13;
+  val ^= val >> 17;
+  val ^= val << 5;
+  return val;
+}
+
+template <bool Lazy>
+void Run(const char *name, const sjtu::vector<unsigned> &input) {
+  using queue = sjtu::priority_queue<unsigned, std::less<unsigned>, Lazy>;
+  size_t n = input.size();
+  queue pushed, built;
+  long long push = TimeMilli([&] {
+    for (size_t i = 0; i < n; ++i) {
+      pushed.push(input[i]);
+    }
+  });
+  long long build = TimeMilli([&] {
+    built = queue(input);
+  });
+  long long push_more = TimeMilli([&] {
+    for (size_t i = 0; i < n; ++i) {
+      pushed.push(input[i]);
+    }
+  });
+  long long push_range = TimeMilli([&] {
+    built.push_range(input);
+  });
+  unsigned long long sum = pushed.top() - built.top() + pushed.size() - built.size();
+  std::cout << name << ": " << n << " pushes " << push << " ms, build " << build << " ms; into a full queue, "
+            << n << " pushes " << push_more << " ms, push_range " << push_range << " ms (checksum " << sum
+            << ", 0 if both agree)\n";
+}
+
+int main(int argc, char **argv) {
+  size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5000000;
+  std::cout << "n = " << n << "\n";
+  sjtu::vector<unsigned> input;
+  input.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    input.push_back(Rand());
+  }
+  Run<false>("eager", input);
+  Run<true>("lazy", input);
+  return 0;
+}
@@ -0,0 +1,65 @@
+// push and pop n random keys, then a mixed workload, on the binomial heap and on d-ary heaps
+// usage: pq_benchmark_dary [n], n = 5000000 by default
+#include "../../../src/dary_heap.hpp"
+#include "../../../src/priority_queue.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+template <class Func>
+long long TimeMilli(Func func) {
+  auto beg = std::chrono::high_resolution_clock::now();
+  func();
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration_cast<std::chrono::milliseconds>(end - beg).count();
+}
+
+unsigned val;
+unsigned Rand() {
+  val ^= val << 13;
+  val ^= val >> 17;
+  val ^= val << 5;
+  return val;
+}
+
+template <class Heap>
+void Run(const char *name, size_t n) {
+  val = 2463534242u;
+  unsigned long long sum = 0;
+  Heap h;
+  long long push = TimeMilli([&] {
+    for (size_t i = 0; i < n; ++i) {
+      h.push(Rand());
+    }
+  });
+  long long pop = TimeMilli([&] {
+    for (size_t i = 0; i < n; ++i) {
+      sum += h.top();
+      h.pop();
+    }
+  });
+  // a queue of steady size n / 10 where every pop is followed by a push
+  for (size_t i = 0; i < n / 10; ++i) {
+    h.push(Rand());
+  }
+  long long mixed = TimeMilli([&] {
+    for (size_t i = 0; i < n; ++i) {
+      sum += h.top();
+      h.pop();
+      h.push(Rand());
+    }
+  });
+  std::cout << name << ": push " << push << " ms, pop " << pop << " ms, pop+push " << mixed
+            << " ms (checksum " << sum << ")\n";
+}
+
+int main(int argc, char **argv) {
+  size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5000000;
+  std::cout << "n = " << n << "\n";
+  Run<sjtu::priority_queue<unsigned>>("binomial", n);
+  Run<sjtu::dary_heap<unsigned, std::less<unsigned>, 2>>("binary", n);
+  Run<sjtu::dary_heap<unsigned, std::less<unsigned>, 4>>("4-ary", n);
+  Run<sjtu::dary_heap<unsigned, std::less<unsigned>, 8>>("8-ary", n);
+  return 0;
+}
@@ -0,0 +1,155 @@
+// Dijkstra on a road-network-sized graph: a side x side grid with random travel times
+// and some random shortcuts, so about 4.2 edges per vertex as in road networks.
+// The pairing heap updates keys in place; the other heaps push duplicates and skip stale entries.
+// usage: pq_benchmark_dijkstra [side], side = 1000 by default
+#include "../../../src/dary_heap.hpp"
+#include "../../../src/pairing_heap.hpp"
+#include "../../../src/priority_queue.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+template <class Func>
+long long TimeMilli(Func func) {
+  auto beg = std::chrono::high_resolution_clock::now();
+  func();
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration_cast<std::chrono::milliseconds>(end - beg).count();
+}
+
+unsigned Rand() {
+  static unsigned val = 2463534242u;
+  val ^= val << 13;
+  val ^= val >> 17;
+  val ^= val << 5;
+  return val;
+}
+
+struct Graph {
+  std::vector<size_t> first; // the edges of v are first[v] .. first[v + 1] - 1
+  std::vector<unsigned> to, weight;
+};
+
+Graph MakeGraph(size_t side) {
+  size_t n = side * side;
+  std::vector<std::vector<std::pair<unsigned, unsigned>>> adj(n);
+  auto add = [&](size_t u, size_t v, unsigned w) {
+    adj[u].push_back({unsigned(v), w});
+    adj[v].push_back({unsigned(u), w});
+  };
+  for (size_t r = 0; r < side; ++r) {
+    for (size_t c = 0; c < side; ++c) {
+      size_t v = r * side + c;
+      if (c + 1 < side) {
+        add(v, v + 1, Rand() % 100 + 1);
+      }
+      if (r + 1 < side) {
+        add(v, v + side, Rand() % 100 + 1);
+      }
+    }
+  }
+  for (size_t i = 0; i < n / 10; ++i) {
+    add(Rand() % n, Rand() % n, Rand() % 5000 + 500);
+  }
+  Graph g;
+  g.first.push_back(0);
+  for (size_t v = 0; v < n; ++v) {
+    for (auto &e : adj[v]) {
+      g.to.push_back(e.first);
+      g.weight.push_back(e.second);
+    }
+    g.first.push_back(g.to.size());
+  }
+  return g;
+}
+
+struct Item {
+  unsigned long long dist;
+  unsigned v;
+  bool operator>(const Item &rhs) const {
+    return dist > rhs.dist;
+  }
+};
+const unsigned long long kInf = ~0ull;
+
+unsigned long long DecreaseKey(const Graph &g, size_t &max_size) {
+  size_t n = g.first.size() - 1;
+  using heap = sjtu::pairing_heap<Item, std::greater<Item>>;
+  std::vector<unsigned long long> dist(n, kInf);
+  std::vector<heap::handle> where(n);
+  std::vector<bool> done(n);
+  heap h;
+  dist[0] = 0;
+  where[0] = h.push({0, 0});
+  while (!h.empty()) {
+    max_size = h.size() > max_size ? h.size() : max_size;
+    Item cur = h.pop_value();
+    done[cur.v] = true;
+    for (size_t e = g.first[cur.v]; e < g.first[cur.v + 1]; ++e) {
+      unsigned v = g.to[e];
+      unsigned long long d = cur.dist + g.weight[e];
+      if (dist[v] == kInf) {
+        dist[v] = d;
+        where[v] = h.push({d, v});
+      } else if (d < dist[v] && !done[v]) {
+        dist[v] = d;
+        h.increase_key(where[v], {d, v});
+      }
+    }
+  }
+  unsigned long long sum = 0;
+  for (size_t v = 0; v < n; ++v) {
+    sum += dist[v];
+  }
+  return sum;
+}
+
+template <class Heap>
+unsigned long long Lazy(const Graph &g, size_t &max_size) {
+  size_t n = g.first.size() - 1;
+  std::vector<unsigned long long> dist(n, kInf);
+  Heap h;
+  dist[0] = 0;
+  h.push({0, 0});
+  while (!h.empty()) {
+    max_size = h.size() > max_size ? h.size() : max_size;
+    Item cur = h.top();
+    h.pop();
+    if (cur.dist != dist[cur.v]) {
+      continue;
+    }
+    for (size_t e = g.first[cur.v]; e < g.first[cur.v + 1]; ++e) {
+      unsigned v = g.to[e];
+      unsigned long long d = cur.dist + g.weight[e];
+      if (d < dist[v]) {
+        dist[v] = d;
+        h.push({d, v});
+      }
+    }
+  }
+  unsigned long long sum = 0;
+  for (size_t v = 0; v < n; ++v) {
+    sum += dist[v];
+  }
+  return sum;
+}
+
+template <class Func>
+void Run(const char *name, Func func) {
+  size_t max_size = 0;
+  unsigned long long sum = 0;
+  long long ms = TimeMilli([&] { sum = func(max_size); });
+  std::cout << name << ": " << ms << " ms, largest heap " << max_size << " (checksum " << sum << ")\n";
+}
+
+int main(int argc, char **argv) {
+  size_t side = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000;
+  Graph g = MakeGraph(side);
+  std::cout << g.first.size() - 1 << " vertices, " << g.to.size() << " arcs\n";
+  Run("pairing, decrease-key", [&](size_t &m) { return DecreaseKey(g, m); });
+  Run("binomial, lazy", [&](size_t &m) { return Lazy<sjtu::priority_queue<Item, std::greater<Item>>>(g, m); });
+  Run("4-ary, lazy", [&](size_t &m) { return Lazy<sjtu::dary_heap<Item, std::greater<Item>, 4>>(g, m); });
+  return 0;
+}
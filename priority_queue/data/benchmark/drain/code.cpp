@@ -0,0 +1,77 @@
+// reading out a priority_queue of n random numbers: summing it by copying and
+// popping the copy against iterating over it, and emptying it in order by popping
+// against drain_sorted, for a comparator that cannot throw and for one that may
+// usage: pq_benchmark_drain [n], n = 2000000 by default
+#include "../../../src/priority_queue.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+template <class Func>
+long long TimeMilli(Func func) {
+  auto beg = std::chrono::high_resolution_clock::now();
+  func();
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration_cast<std::chrono::milliseconds>(end - beg).count();
+}
+
+unsigned Rand() {
+  static unsigned val = 2463534242u;
+  val ^= val << 13;
+  val ^= val >> 17;
+  val ^= val << 5;
+  return val;
+}
+
+// std::less without the noexcept guarantee, so that drain_sorted takes its careful path
+struct MayThrowLess {
+  bool operator()(unsigned a, unsigned b) const {
+    return a < b;
+  }
+};
+
+template <class Compare>
+void Run(const char *name, size_t n) {
+  sjtu::priority_queue<unsigned, Compare> q;
+  for (size_t i = 0; i < n; ++i) {
+    q.push(Rand());
+  }
+  unsigned long long sum = 0;
+  long long copy_pop = TimeMilli([&] {
+    sjtu::priority_queue<unsigned, Compare> copy = q;
+    while (!copy.empty()) {
+      sum += copy.top();
+      copy.pop();
+    }
+  });
+  long long iterate = TimeMilli([&] {
+    for (unsigned x : q) {
+      sum -= x;
+    }
+  });
+  sjtu::priority_queue<unsigned, Compare> copy = q;
+  long long pop = TimeMilli([&] {
+    while (!copy.empty()) {
+      sum += copy.top();
+      copy.pop();
+    }
+  });
+  sjtu::vector<unsigned> out;
+  long long drain = TimeMilli([&] {
+    q.drain_sorted(out);
+  });
+  for (size_t i = 0; i < out.size(); ++i) {
+    sum -= out[i];
+  }
+  std::cout << name << ": copy and pop " << copy_pop << " ms, iterate " << iterate << " ms, pop all " << pop
+            << " ms, drain_sorted " << drain << " ms (checksum " << sum << ", 0 if all agree)\n";
+}
+
+int main(int argc, char **argv) {
+  size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+  std::cout << "n = " << n << "\n";
+  Run<std::less<unsigned>>("std::less", n);
+  Run<MayThrowLess>("may throw", n);
+  return 0;
+}
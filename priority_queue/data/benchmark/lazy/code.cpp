@@ -0,0 +1,61 @@
+// bursts of pushes and merges followed by a few pops, on the eager and the lazy binomial heap
+// usage: pq_benchmark_lazy [burst], burst = 300000 pushes per round by default
+#include "../../../src/priority_queue.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+template <class Func>
+long long TimeMilli(Func func) {
+  auto beg = std::chrono::high_resolution_clock::now();
+  func();
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration_cast<std::chrono::milliseconds>(end - beg).count();
+}
+
+unsigned val;
+unsigned Rand() {
+  val ^= val << 13;
+  val ^= val >> 17;
+  val ^= val << 5;
+  return val;
+}
+
+template <bool Lazy>
+void Run(const char *name, size_t burst) {
+  val = 2463534242u;
+  using queue = sjtu::priority_queue<unsigned, std::less<unsigned>, Lazy>;
+  const int kRounds = 20, kParts = 8, kPops = 10;
+  unsigned long long sum = 0;
+  long long push = 0, merge = 0, pop = 0;
+  queue q;
+  for (int round = 0; round < kRounds; ++round) {
+    queue parts[kParts];
+    push += TimeMilli([&] {
+      for (size_t i = 0; i < burst; ++i) {
+        parts[i % kParts].push(Rand());
+      }
+    });
+    merge += TimeMilli([&] {
+      for (int i = 0; i < kParts; ++i) {
+        q.merge(parts[i]);
+      }
+    });
+    pop += TimeMilli([&] {
+      for (int i = 0; i < kPops; ++i) {
+        sum += q.top();
+        q.pop();
+      }
+    });
+  }
+  std::cout << name << ": push " << push << " ms, merge " << merge << " ms, pop " << pop
+            << " ms, total " << push + merge + pop << " ms (checksum " << sum << ")\n";
+}
+
+int main(int argc, char **argv) {
+  size_t burst = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 300000;
+  Run<false>("eager", burst);
+  Run<true>("lazy", burst);
+  return 0;
+}
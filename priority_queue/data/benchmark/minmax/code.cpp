@@ -0,0 +1,72 @@
+// the min-max heap: building from n elements with the O(n) constructor against n
+// pushes, then draining it from both ends against a priority_queue drained from one
+// usage: pq_benchmark_minmax [n], n = 5000000 by default
+#include "../../../src/minmax_heap.hpp"
+#include "../../../src/priority_queue.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+template <class Func>
+long long TimeMilli(Func func) {
+  auto beg = std::chrono::high_resolution_clock::now();
+  func();
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration_cast<std::chrono::milliseconds>(end - beg).count();
+}
+
+unsigned Rand() {
+  static unsigned val = 2463534242u;
+  val ^= val << 13;
+  val ^= val >> 17;
+  val ^= val << 5;
+  return val;
+}
+
+int main(int argc, char **argv) {
+  size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5000000;
+  std::cout << "n = " << n << "\n";
+  sjtu::vector<unsigned> input;
+  input.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    input.push_back(Rand());
+  }
+  unsigned long long sum = 0;
+  sjtu::minmax_heap<unsigned> pushed;
+  long long push = TimeMilli([&] {
+    for (size_t i = 0; i < n; ++i) {
+      pushed.push(input[i]);
+    }
+  });
+  sjtu::minmax_heap<unsigned> built;
+  long long build = TimeMilli([&] {
+    built = sjtu::minmax_heap<unsigned>(input);
+  });
+  long long drain = TimeMilli([&] {
+    while (!built.empty()) {
+      sum += built.min();
+      built.pop_min();
+      if (!built.empty()) {
+        sum -= built.max();
+        built.pop_max();
+      }
+    }
+  });
+  sjtu::priority_queue<unsigned> q;
+  long long queue_push = TimeMilli([&] {
+    for (size_t i = 0; i < n; ++i) {
+      q.push(input[i]);
+    }
+  });
+  long long queue_drain = TimeMilli([&] {
+    while (!q.empty()) {
+      sum += q.top();
+      q.pop();
+    }
+  });
+  std::cout << "minmax_heap: " << n << " pushes " << push << " ms, build " << build << " ms, drain from both ends "
+            << drain << " ms\npriority_queue: " << n << " pushes " << queue_push << " ms, drain " << queue_drain
+            << " ms (checksum " << sum << ", " << pushed.size() << ")\n";
+  return 0;
+}
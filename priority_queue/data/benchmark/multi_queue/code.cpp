@@ -0,0 +1,138 @@
+// throughput of multi_queue against one mutex around sjtu::priority_queue, 1 to 32 threads,
+// and the rank error of multi_queue for the number of heaps those thread counts give
+// usage: pq_benchmark_multi_queue [ops], ops = 4000000 pop+push pairs in total by default
+#include "../../../src/multi_queue.hpp"
+#include "../../../src/priority_queue.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+template <class Func>
+long long TimeMicro(Func func) {
+  auto beg = std::chrono::high_resolution_clock::now();
+  func();
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - beg).count();
+}
+
+template <class Func>
+void RunWorkers(int threads, Func func) {
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back(func, t);
+  }
+  for (std::thread &w : workers) {
+    w.join();
+  }
+}
+
+unsigned Next(unsigned &val) {
+  val ^= val << 13;
+  val ^= val >> 17;
+  val ^= val << 5;
+  return val;
+}
+
+const size_t kPrefill = 1000000;
+
+// every worker pops the best task and pushes a new one a little later, as a scheduler does
+double LockedRate(int threads, size_t ops) {
+  sjtu::priority_queue<unsigned, std::greater<unsigned>> q;
+  std::mutex mutex;
+  unsigned seed = 2463534242u;
+  for (size_t i = 0; i < kPrefill; ++i) {
+    q.push(Next(seed) >> 8);
+  }
+  long long us = TimeMicro([&] {
+    RunWorkers(threads, [&](int t) {
+      unsigned val = 12345 + t;
+      for (size_t i = 0; i < ops / threads; ++i) {
+        std::lock_guard<std::mutex> lock(mutex);
+        unsigned x = q.top();
+        q.pop();
+        q.push(x + (Next(val) >> 20));
+      }
+    });
+  });
+  return double(ops) / us;
+}
+
+double RelaxedRate(int threads, size_t ops, size_t factor) {
+  sjtu::multi_queue<unsigned, std::greater<unsigned>> q(threads, factor);
+  unsigned seed = 2463534242u;
+  for (size_t i = 0; i < kPrefill; ++i) {
+    q.push(Next(seed) >> 8);
+  }
+  long long us = TimeMicro([&] {
+    RunWorkers(threads, [&](int t) {
+      unsigned val = 12345 + t, x;
+      for (size_t i = 0; i < ops / threads; ++i) {
+        if (q.try_pop(x)) {
+          q.push(x + (Next(val) >> 20));
+        }
+      }
+    });
+  });
+  return double(ops) / us;
+}
+
+// Rank error of each pop, measured on one thread so that it can be exact: the number of
+// elements still queued that are better than the popped one. Keys 0 .. n - 1 are pushed
+// in random order, and a Fenwick tree counts the ones left below a key.
+void RankError(size_t heaps, size_t n, double &mean, size_t &worst) {
+  sjtu::multi_queue<unsigned, std::greater<unsigned>> q(heaps, 1);
+  std::vector<unsigned> keys(n);
+  for (size_t i = 0; i < n; ++i) {
+    keys[i] = i;
+  }
+  unsigned seed = 88172645u;
+  for (size_t i = n - 1; i > 0; --i) {
+    std::swap(keys[i], keys[Next(seed) % (i + 1)]);
+  }
+  std::vector<int> tree(n + 1);
+  for (unsigned k : keys) {
+    q.push(k);
+    for (size_t i = k + 1; i <= n; i += i & -i) {
+      ++tree[i];
+    }
+  }
+  unsigned long long total = 0;
+  worst = 0;
+  unsigned x;
+  while (q.try_pop(x)) {
+    size_t below = 0;
+    for (size_t i = x; i > 0; i -= i & -i) {
+      below += tree[i];
+    }
+    for (size_t i = x + 1; i <= n; i += i & -i) {
+      --tree[i];
+    }
+    total += below;
+    worst = below > worst ? below : worst;
+  }
+  mean = double(total) / n;
+}
+
+int main(int argc, char **argv) {
+  size_t ops = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+  std::cout << ops << " pop+push pairs on a queue of " << kPrefill << ", in million pairs per second ("
+            << std::thread::hardware_concurrency() << " hardware threads)\n";
+  std::cout << "threads\tmutex+binomial\tmulti_queue c=2\tmulti_queue c=4\n";
+  for (int threads : {1, 2, 4, 8, 16, 32}) {
+    std::cout << threads << "\t" << LockedRate(threads, ops) << "\t" << RelaxedRate(threads, ops, 2) << "\t"
+              << RelaxedRate(threads, ops, 4) << "\n";
+  }
+  std::cout << "rank error of multi_queue popping 1000000 keys\n";
+  std::cout << "heaps\tmean\tmax\n";
+  for (size_t heaps : {2, 4, 8, 16, 32, 64, 128}) {
+    double mean;
+    size_t worst;
+    RankError(heaps, 1000000, mean, worst);
+    std::cout << heaps << "\t" << mean << "\t" << worst << "\n";
+  }
+  return 0;
+}
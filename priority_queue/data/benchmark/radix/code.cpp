@@ -0,0 +1,118 @@
+// Dijkstra on a side x side grid with random edge weights, with the radix heap
+// against the binomial heap, both pushing duplicates and skipping stale entries
+// usage: pq_benchmark_radix [side], side = 1000 by default
+#include "../../../src/priority_queue.hpp"
+#include "../../../src/radix_heap.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+template <class Func>
+long long TimeMilli(Func func) {
+  auto beg = std::chrono::high_resolution_clock::now();
+  func();
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration_cast<std::chrono::milliseconds>(end - beg).count();
+}
+
+unsigned Rand() {
+  static unsigned val = 2463534242u;
+  val ^= val << 13;
+  val ^= val >> 17;
+  val ^= val << 5;
+  return val;
+}
+
+size_t side;
+std::vector<unsigned> right_w, down_w; // weight of the edge to the right / below each cell
+
+template <class Visit>
+void Neighbours(unsigned v, Visit visit) {
+  size_t r = v / side, c = v % side;
+  if (c + 1 < side) {
+    visit(v + 1, right_w[v]);
+  }
+  if (c > 0) {
+    visit(v - 1, right_w[v - 1]);
+  }
+  if (r + 1 < side) {
+    visit(v + side, down_w[v]);
+  }
+  if (r > 0) {
+    visit(v - side, down_w[v - side]);
+  }
+}
+
+unsigned long long Checksum(const std::vector<unsigned> &dist) {
+  unsigned long long sum = 0;
+  for (unsigned d : dist) {
+    sum += d;
+  }
+  return sum;
+}
+
+unsigned long long Radix() {
+  std::vector<unsigned> dist(side * side, ~0u);
+  sjtu::radix_heap<unsigned, unsigned> h;
+  dist[0] = 0;
+  h.push(0, 0);
+  while (!h.empty()) {
+    unsigned d = h.top().first, v = h.top().second;
+    h.pop();
+    if (d != dist[v]) {
+      continue;
+    }
+    Neighbours(v, [&](unsigned u, unsigned w) {
+      if (d + w < dist[u]) {
+        dist[u] = d + w;
+        h.push(d + w, u);
+      }
+    });
+  }
+  return Checksum(dist);
+}
+
+struct Item {
+  unsigned dist, v;
+  bool operator>(const Item &rhs) const {
+    return dist > rhs.dist;
+  }
+};
+
+unsigned long long Binomial() {
+  std::vector<unsigned> dist(side * side, ~0u);
+  sjtu::priority_queue<Item, std::greater<Item>> h;
+  dist[0] = 0;
+  h.push({0, 0});
+  while (!h.empty()) {
+    Item cur = h.top();
+    h.pop();
+    if (cur.dist != dist[cur.v]) {
+      continue;
+    }
+    Neighbours(cur.v, [&](unsigned u, unsigned w) {
+      if (cur.dist + w < dist[u]) {
+        dist[u] = cur.dist + w;
+        h.push({cur.dist + w, u});
+      }
+    });
+  }
+  return Checksum(dist);
+}
+
+int main(int argc, char **argv) {
+  side = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000;
+  right_w.resize(side * side);
+  down_w.resize(side * side);
+  for (size_t i = 0; i < side * side; ++i) {
+    right_w[i] = Rand() % 100 + 1;
+    down_w[i] = Rand() % 100 + 1;
+  }
+  std::cout << side << " x " << side << " grid\n";
+  unsigned long long sum = 0;
+  std::cout << "radix: " << TimeMilli([&] { sum = Radix(); }) << " ms (checksum " << sum << ")\n";
+  std::cout << "binomial: " << TimeMilli([&] { sum = Binomial(); }) << " ms (checksum " << sum << ")\n";
+  return 0;
+}
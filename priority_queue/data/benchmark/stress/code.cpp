@@ -0,0 +1,72 @@
+// builds, copies and destroys very large heaps; none of these may recurse along the trees
+// usage: pq_benchmark_stress [n], n = 100000000 by default
+#include "../../../src/priority_queue.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+template <class Func>
+long long TimeMilli(Func func) {
+  auto beg = std::chrono::high_resolution_clock::now();
+  func();
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration_cast<std::chrono::milliseconds>(end - beg).count();
+}
+
+unsigned Rand() {
+  static unsigned val = 2463534242u;
+  val ^= val << 13;
+  val ^= val >> 17;
+  val ^= val << 5;
+  return val;
+}
+
+// not trivially destructible, so destruction has to walk every tree
+struct Counted {
+  static long long alive;
+  unsigned value;
+  Counted(unsigned v) : value(v) { ++alive; }
+  Counted(const Counted &other) : value(other.value) { ++alive; }
+  ~Counted() { --alive; }
+  bool operator<(const Counted &rhs) const { return value < rhs.value; }
+};
+long long Counted::alive = 0;
+
+int main(int argc, char **argv) {
+  size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000000;
+  {
+    sjtu::priority_queue<unsigned> q;
+    std::cout << "push " << n << ": " << TimeMilli([&] {
+      q.reserve(n);
+      for (size_t i = 0; i < n; ++i) {
+        q.push(Rand());
+      }
+    }) << " ms\n";
+    unsigned top = 0;
+    std::cout << "pop 1000: " << TimeMilli([&] {
+      for (int i = 0; i < 1000; ++i) {
+        top = q.top();
+        q.pop();
+      }
+    }) << " ms (top " << top << ")\n";
+    std::cout << "destroy: " << TimeMilli([&] { q.~priority_queue(); new(&q) sjtu::priority_queue<unsigned>(); }) << " ms\n";
+  }
+  // a copy needs twice the memory, so it is done at a quarter of the size
+  size_t m = n / 4;
+  {
+    sjtu::priority_queue<Counted> q;
+    for (size_t i = 0; i < m; ++i) {
+      q.push(Counted(Rand()));
+    }
+    sjtu::priority_queue<Counted> *copy = nullptr;
+    std::cout << "copy " << m << ": " << TimeMilli([&] { copy = new sjtu::priority_queue<Counted>(q); }) << " ms\n";
+    std::cout << "destroy copy: " << TimeMilli([&] { delete copy; }) << " ms\n";
+    sjtu::priority_queue<Counted> shared;
+    shared.share_pool(q);
+    shared.push(Counted(0));
+    std::cout << "destroy node by node: " << TimeMilli([&] { q.~priority_queue(); new(&q) sjtu::priority_queue<Counted>(); }) << " ms\n";
+  }
+  std::cout << "alive after all: " << Counted::alive << "\n";
+  return 0;
+}
@@ -0,0 +1,74 @@
+// the k largest of a stream of n random numbers, kept by top_k against a
+// priority_queue of k elements under std::greater that pops its smallest when full
+// usage: pq_benchmark_top_k [n] [k], n = 20000000 and k = 1000 by default
+#include "../../../src/priority_queue.hpp"
+#include "../../../src/top_k.hpp"
+
+#include <cstdlib>
+#include <chrono>
+#include <functional>
+#include <iostream>
+
+template <class Func>
+long long TimeMilli(Func func) {
+  auto beg = std::chrono::high_resolution_clock::now();
+  func();
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration_cast<std::chrono::milliseconds>(end - beg).count();
+}
+
+unsigned Rand() {
+  static unsigned val = 2463534242u;
+  val ^= val << 13;
+  val ^= val >> 17;
+  val ^= val << 5;
+  return val;
+}
+
+int main(int argc, char **argv) {
+  size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000000;
+  size_t k = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000;
+  std::cout << "n = " << n << ", k = " << k << "\n";
+  sjtu::vector<unsigned> stream;
+  stream.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    stream.push_back(Rand());
+  }
+  unsigned long long sum = 0;
+  long long queue = TimeMilli([&] {
+    sjtu::priority_queue<unsigned, std::greater<unsigned>> q;
+    for (size_t i = 0; i < n; ++i) {
+      if (q.size() < k) {
+        q.push(stream[i]);
+      } else if (q.top() < stream[i]) {
+        q.pop();
+        q.push(stream[i]);
+      }
+    }
+    while (!q.empty()) {
+      sum += q.top();
+      q.pop();
+    }
+  });
+  long long top = TimeMilli([&] {
+    sjtu::top_k<unsigned> t(k);
+    for (size_t i = 0; i < n; ++i) {
+      t.push(stream[i]);
+    }
+    sjtu::vector<unsigned> out;
+    t.drain_sorted(out);
+    for (size_t i = 0; i < out.size(); ++i) {
+      sum -= out[i];
+    }
+  });
+  // streams in ascending order, so that every element is kept
+  long long worst = TimeMilli([&] {
+    sjtu::top_k<unsigned> t(k);
+    for (size_t i = 0; i < n; ++i) {
+      t.push(static_cast<unsigned>(i));
+    }
+  });
+  std::cout << "priority_queue: " << queue << " ms, top_k: " << top << " ms, top_k on an ascending stream: "
+            << worst << " ms (checksum " << sum << ", 0 if both agree)\n";
+  return 0;
+}
@@ -0,0 +1,200 @@
+#include <iostream>
+#include <string>
+#include "priority_queue.hpp"
+
+int A = 325, B = 2336, last = 233, mod = 1000007;
+
+int Rand(){
+	return last = (A * last + B) % mod;
+}
+
+// throws once budget comparisons have been made, if budget is not negative
+struct Budget {
+	static int budget;
+	bool operator()(int a, int b) const {
+		if (budget == 0) {
+			throw sjtu::runtime_error();
+		}
+		if (budget > 0) {
+			--budget;
+		}
+		return a < b;
+	}
+};
+int Budget::budget = -1;
+
+// copying a Fragile with value -1 throws
+struct Fragile {
+	int value;
+	Fragile(int v) : value(v) {}
+	Fragile(const Fragile &other) : value(other.value) {
+		if (value == -1) {
+			throw sjtu::runtime_error();
+		}
+	}
+	Fragile(Fragile &&other) noexcept = default;
+	Fragile &operator=(const Fragile &other) = default;
+	Fragile &operator=(Fragile &&other) noexcept = default;
+	bool operator<(const Fragile &rhs) const {
+		return value < rhs.value;
+	}
+};
+
+template<class Q, class R>
+bool Same(Q a, R b)
+{
+	bool same = a.size() == b.size();
+	while (same && !a.empty()) {
+		same = a.top() == b.top();
+		a.pop();
+		b.pop();
+	}
+	return same;
+}
+
+template<bool Lazy>
+void TestBuild()
+{
+	std::cout << "Testing bulk construction" << (Lazy ? " in lazy mode" : "") << "..." << std::endl;
+	for (size_t n : {0, 1, 2, 3, 7, 8, 9, 1000, 65537}) {
+		sjtu::vector<int> v;
+		sjtu::priority_queue<int> pushed;
+		for (size_t i = 0; i < n; ++i) {
+			int x = Rand() % 10000;
+			v.push_back(x);
+			pushed.push(x);
+		}
+		sjtu::priority_queue<int, std::less<int>, Lazy> a(v), b(v.data(), v.data() + v.size());
+		bool same = Same(a, pushed) && Same(b, pushed);
+		if (n > 0) {
+			a.pop();
+			a.push(-1);
+			pushed.pop();
+			pushed.push(-1);
+			same = same && Same(a, pushed) && a.top() == pushed.top();
+		}
+		std::cout << n << ": " << a.size() << " " << (same ? "same" : "different") << std::endl;
+	}
+}
+
+template<bool Lazy>
+void TestPushRange()
+{
+	std::cout << "Testing push_range" << (Lazy ? " in lazy mode" : "") << "..." << std::endl;
+	sjtu::priority_queue<int, std::less<int>, Lazy> q;
+	sjtu::priority_queue<int> ref;
+	long long sum = 0;
+	bool same = true;
+	for (int round = 0; round < 200; ++round) {
+		sjtu::vector<int> v;
+		int n = Rand() % 300;
+		for (int i = 0; i < n; ++i) {
+			v.push_back(Rand() % 100000);
+			ref.push(v.back());
+		}
+		if (round % 2 == 0) {
+			q.push_range(v);
+		} else {
+			q.push_range(v.begin(), v.end());
+		}
+		int pops = Rand() % 250;
+		for (int i = 0; i < pops && !q.empty(); ++i) {
+			same = same && q.top() == ref.top();
+			sum += q.top();
+			q.pop();
+			ref.pop();
+		}
+	}
+	std::cout << q.size() << " " << sum << " " << (same && Same(q, ref) ? "same" : "different") << std::endl;
+}
+
+template<bool Lazy>
+void TestRollback()
+{
+	std::cout << "Testing a throwing comparator" << (Lazy ? " in lazy mode" : "") << "..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 200; ++i) {
+		v.push_back(Rand() % 1000);
+	}
+	int caught = 0, unchanged = 0;
+	for (int budget = 0; budget < 260; budget += 7) {
+		Budget::budget = budget;
+		try {
+			sjtu::priority_queue<int, Budget, Lazy> q(v);
+		} catch (const sjtu::runtime_error &) {
+			++caught;
+		}
+		Budget::budget = -1;
+	}
+	std::cout << "construction: caught " << caught << std::endl;
+	sjtu::priority_queue<int, Budget, Lazy> q;
+	for (int i = 0; i < 100; ++i) {
+		q.push(Rand() % 1000);
+	}
+	caught = 0;
+	for (int budget = 0; budget < 260; budget += 7) {
+		sjtu::priority_queue<int, Budget, Lazy> before = q;
+		Budget::budget = budget;
+		try {
+			q.push_range(v);
+			Budget::budget = -1;
+			q = before;
+		} catch (const sjtu::runtime_error &) {
+			Budget::budget = -1;
+			++caught;
+			unchanged += Same(q, before);
+		}
+		Budget::budget = -1;
+	}
+	std::cout << "push_range: caught " << caught << ", unchanged " << unchanged << ", size " << q.size() << std::endl;
+}
+
+void TestThrowingCopy()
+{
+	std::cout << "Testing a throwing copy..." << std::endl;
+	sjtu::vector<Fragile> v;
+	for (int i = 0; i < 100; ++i) {
+		v.push_back(Fragile(Rand() % 1000));
+	}
+	v[57] = Fragile(-1);
+	try {
+		sjtu::priority_queue<Fragile> q(v);
+		std::cout << "not thrown" << std::endl;
+	} catch (const sjtu::runtime_error &) {
+		std::cout << "construction thrown" << std::endl;
+	}
+	sjtu::priority_queue<Fragile> q(v.data(), v.data() + 57);
+	int top = q.top().value;
+	try {
+		q.push_range(v);
+	} catch (const sjtu::runtime_error &) {
+		std::cout << "push_range thrown" << std::endl;
+	}
+	std::cout << q.size() << " " << (q.top().value == top ? "unchanged" : "changed") << std::endl;
+}
+
+void TestStrings()
+{
+	std::cout << "Testing strings..." << std::endl;
+	std::string words[] = {"pear", "apple", "fig", "plum", "kiwi", "lime", "date"};
+	sjtu::priority_queue<std::string, std::greater<std::string>> q(words, words + 7);
+	q.push_range(words, words + 3);
+	while (!q.empty()) {
+		std::cout << q.top() << " ";
+		q.pop();
+	}
+	std::cout << std::endl;
+}
+
+int main()
+{
+	TestBuild<false>();
+	TestBuild<true>();
+	TestPushRange<false>();
+	TestPushRange<true>();
+	TestRollback<false>();
+	TestRollback<true>();
+	TestThrowingCopy();
+	TestStrings();
+	return 0;
+}
@@ -0,0 +1,132 @@
+#include <iostream>
+#include <string>
+#include "dary_heap.hpp"
+#include "priority_queue.hpp"
+
+int A = 325, B = 2336, last = 233, mod = 1000007;
+
+int Rand(){
+	return last = (A * last + B) % mod;
+}
+
+// throws once budget comparisons have been made, if budget is not negative
+struct Budget {
+	static int budget;
+	bool operator()(int a, int b) const {
+		if (budget == 0) {
+			throw sjtu::runtime_error();
+		}
+		if (budget > 0) {
+			--budget;
+		}
+		return a < b;
+	}
+};
+int Budget::budget = -1;
+
+template<size_t D>
+void TestAgainstBinomial()
+{
+	std::cout << "Testing arity " << D << "..." << std::endl;
+	sjtu::dary_heap<int, std::less<int>, D> h;
+	sjtu::priority_queue<int> q;
+	long long sum = 0;
+	bool same = true;
+	for (int i = 0; i < 200000; ++i) {
+		if (Rand() % 3 != 0 || q.empty()) {
+			int x = Rand() % 100000;
+			h.push(x);
+			q.push(x);
+		} else {
+			same = same && h.top() == q.top();
+			sum += h.top();
+			if (i % 2 == 0) {
+				h.pop();
+			} else {
+				h.pop_value();
+			}
+			q.pop();
+		}
+	}
+	std::cout << h.size() << " " << q.size() << " " << sum << std::endl;
+	while (!q.empty()) {
+		same = same && h.top() == q.top();
+		h.pop();
+		q.pop();
+	}
+	std::cout << (same && h.empty() ? "same order" : "different order") << std::endl;
+}
+
+void TestRollback()
+{
+	std::cout << "Testing a throwing comparator..." << std::endl;
+	sjtu::dary_heap<int, Budget, 3> h;
+	for (int i = 0; i < 500; ++i) {
+		h.push(Rand() % 1000);
+	}
+	int caught = 0, unchanged = 0;
+	for (int budget = 0; budget < 40; ++budget) {
+		sjtu::dary_heap<int, Budget, 3> before = h;
+		Budget::budget = budget;
+		try {
+			if (budget % 2 == 0) {
+				h.push(Rand() % 2000);
+			} else {
+				h.pop();
+			}
+		} catch (const sjtu::runtime_error &) {
+			Budget::budget = -1;
+			++caught;
+			sjtu::dary_heap<int, Budget, 3> after = h;
+			bool same = after.size() == before.size();
+			while (same && !after.empty()) {
+				same = after.pop_value() == before.pop_value();
+			}
+			unchanged += same;
+		}
+		Budget::budget = -1;
+	}
+	std::cout << "caught " << caught << ", unchanged " << unchanged << ", size " << h.size() << std::endl;
+	int prev = h.top(), sorted = 1;
+	while (!h.empty()) {
+		sorted &= h.top() <= prev;
+		prev = h.pop_value();
+	}
+	std::cout << (sorted ? "still a heap" : "broken") << std::endl;
+}
+
+void TestCopyAndMove()
+{
+	std::cout << "Testing copies and moves..." << std::endl;
+	sjtu::dary_heap<std::string> a;
+	try {
+		a.top();
+	} catch (const sjtu::container_is_empty &) {
+		std::cout << "empty top" << std::endl;
+	}
+	try {
+		a.pop();
+	} catch (const sjtu::container_is_empty &) {
+		std::cout << "empty pop" << std::endl;
+	}
+	for (int i = 0; i < 50; ++i) {
+		a.push(std::to_string(Rand()));
+	}
+	sjtu::dary_heap<std::string> b = a;
+	sjtu::dary_heap<std::string> c(std::move(a));
+	std::cout << a.size() << " " << b.size() << " " << c.size() << " " << c.top() << std::endl;
+	b.pop();
+	a = b;
+	c = std::move(b);
+	std::cout << a.size() << " " << b.size() << " " << c.size() << " " << a.top() << " " << c.top() << std::endl;
+}
+
+int main()
+{
+	TestAgainstBinomial<2>();
+	TestAgainstBinomial<4>();
+	TestAgainstBinomial<8>();
+	TestRollback();
+	TestCopyAndMove();
+	return 0;
+}
@@ -0,0 +1,185 @@
+#include <iostream>
+#include <memory>
+#include <string>
+#include "priority_queue.hpp"
+
+int A = 325, B = 2336, last = 233, mod = 1000007;
+
+int Rand(){
+	return last = (A * last + B) % mod;
+}
+
+// throws once budget comparisons have been made, if budget is not negative
+struct Budget {
+	static int budget;
+	bool operator()(int a, int b) const {
+		if (budget == 0) {
+			throw sjtu::runtime_error();
+		}
+		if (budget > 0) {
+			--budget;
+		}
+		return a < b;
+	}
+};
+int Budget::budget = -1;
+
+struct PtrLess {
+	bool operator()(const std::unique_ptr<int> &a, const std::unique_ptr<int> &b) const noexcept {
+		return *a < *b;
+	}
+};
+
+// counts how often each value in [0, 1000) occurs among the elements
+template<class Q>
+sjtu::vector<int> Histogram(const Q &q)
+{
+	sjtu::vector<int> count(1000, 0);
+	for (auto it = q.begin(); it != q.end(); ++it) {
+		++count[*it];
+	}
+	return count;
+}
+
+template<class Q>
+bool SameAsPopping(Q q, const sjtu::vector<int> &out)
+{
+	bool same = q.size() == out.size();
+	for (size_t i = 0; same && i < out.size(); ++i) {
+		same = q.top() == out[i];
+		q.pop();
+	}
+	return same;
+}
+
+template<bool Lazy>
+void TestIterate()
+{
+	std::cout << "Testing iteration" << (Lazy ? " in lazy mode" : "") << "..." << std::endl;
+	sjtu::priority_queue<int, std::less<int>, Lazy> q;
+	std::cout << (q.begin() == q.end() ? "empty range" : "not empty") << std::endl;
+	try {
+		*q.end();
+	} catch (const sjtu::invalid_iterator &) {
+		std::cout << "end is not dereferenceable" << std::endl;
+	}
+	sjtu::vector<int> count(1000, 0);
+	bool same = true;
+	for (int i = 0; i < 30000; ++i) {
+		if (Rand() % 4 != 0 || q.empty()) {
+			int x = Rand() % 1000;
+			q.push(x);
+			++count[x];
+		} else {
+			--count[q.top()];
+			q.pop();
+		}
+		if (i % 1000 == 0) {
+			sjtu::vector<int> seen = Histogram(q);
+			for (int j = 0; j < 1000; ++j) {
+				same = same && seen[j] == count[j];
+			}
+		}
+	}
+	size_t n = 0;
+	long long sum = 0;
+	for (int x : q) {
+		++n;
+		sum += x;
+	}
+	std::cout << q.size() << " " << n << " " << sum << " " << (same ? "same elements" : "different elements") << std::endl;
+	sjtu::vector<int> out;
+	sjtu::priority_queue<int, std::less<int>, Lazy> copy = q;
+	q.drain_sorted(out);
+	std::cout << q.size() << " " << out.size() << " " << (SameAsPopping(copy, out) ? "sorted" : "not sorted") << std::endl;
+	q.push(5);
+	q.drain_sorted(out);
+	std::cout << q.size() << " " << out.size() << " " << out[0] << std::endl;
+	q.drain_sorted(out);
+	std::cout << out.size() << std::endl;
+}
+
+void TestThrowingDrain()
+{
+	std::cout << "Testing drain_sorted with a throwing comparator..." << std::endl;
+	sjtu::priority_queue<int, Budget> q;
+	for (int i = 0; i < 3000; ++i) {
+		q.push(Rand() % 1000);
+	}
+	sjtu::priority_queue<int, Budget> copy = q;
+	sjtu::vector<int> before = Histogram(q), out;
+	int caught = 0;
+	for (int budget = 0; budget < 50000; budget += 997) {
+		Budget::budget = budget;
+		try {
+			q.drain_sorted(out);
+			Budget::budget = -1;
+			break;
+		} catch (const sjtu::runtime_error &) {
+			++caught;
+		}
+		Budget::budget = -1;
+		sjtu::vector<int> after = Histogram(q);
+		bool same = q.size() == 3000;
+		for (int j = 0; j < 1000; ++j) {
+			same = same && after[j] == before[j];
+		}
+		if (!same) {
+			std::cout << "changed after a failed drain" << std::endl;
+		}
+	}
+	std::cout << "caught " << caught << ", " << q.size() << " " << out.size() << " "
+		<< (SameAsPopping(copy, out) ? "sorted" : "not sorted") << std::endl;
+}
+
+void TestMoveOnly()
+{
+	std::cout << "Testing move-only elements..." << std::endl;
+	sjtu::priority_queue<std::unique_ptr<int>, PtrLess> q;
+	for (int i = 0; i < 100; ++i) {
+		q.push(std::make_unique<int>(Rand() % 500));
+	}
+	long long sum = 0;
+	for (auto it = q.begin(); it != q.end(); it++) {
+		sum += **it;
+	}
+	sjtu::vector<std::unique_ptr<int>> out;
+	q.drain_sorted(out);
+	bool sorted = true;
+	for (size_t i = 1; i < out.size(); ++i) {
+		sorted = sorted && *out[i] <= *out[i - 1];
+	}
+	std::cout << sum << " " << q.size() << " " << out.size() << " " << *out[0] << " "
+		<< (sorted ? "sorted" : "not sorted") << std::endl;
+}
+
+void TestStrings()
+{
+	std::cout << "Testing strings..." << std::endl;
+	sjtu::priority_queue<std::string, std::greater<std::string>> q;
+	for (int i = 0; i < 20; ++i) {
+		q.push(std::to_string(Rand() % 100));
+	}
+	size_t length = 0;
+	for (auto it = q.begin(); it != q.end(); ++it) {
+		length += it->size();
+	}
+	sjtu::vector<std::string> out;
+	out.push_back("old");
+	q.drain_sorted(out);
+	std::cout << length << ":";
+	for (size_t i = 0; i < out.size(); ++i) {
+		std::cout << " " << out[i];
+	}
+	std::cout << std::endl;
+}
+
+int main()
+{
+	TestIterate<false>();
+	TestIterate<true>();
+	TestThrowingDrain();
+	TestMoveOnly();
+	TestStrings();
+	return 0;
+}
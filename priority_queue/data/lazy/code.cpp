@@ -0,0 +1,231 @@
+#include <iostream>
+#include <string>
+#include "priority_queue.hpp"
+
+int A = 325, B = 2336, last = 233, mod = 1000007;
+
+int Rand(){
+	return last = (A * last + B) % mod;
+}
+
+// throws once budget comparisons have been made, if budget is not negative
+struct Budget {
+	static int budget;
+	static long long made;
+	bool operator()(int a, int b) const {
+		if (budget == 0) {
+			throw sjtu::runtime_error();
+		}
+		if (budget > 0) {
+			--budget;
+		}
+		++made;
+		return a < b;
+	}
+};
+int Budget::budget = -1;
+long long Budget::made = 0;
+
+// like Budget, but throws an int, which the queue must report as runtime_error
+struct Foreign {
+	static int budget;
+	bool operator()(int a, int b) const {
+		if (budget == 0) {
+			throw 42;
+		}
+		if (budget > 0) {
+			--budget;
+		}
+		return a < b;
+	}
+};
+int Foreign::budget = -1;
+
+template<class Q>
+bool Same(Q a, sjtu::priority_queue<int> b)
+{
+	if (a.size() != b.size()) {
+		return false;
+	}
+	while (!a.empty()) {
+		if (a.top() != b.top()) {
+			return false;
+		}
+		a.pop();
+		b.pop();
+	}
+	return true;
+}
+
+void TestAgainstEager()
+{
+	std::cout << "Testing lazy against eager..." << std::endl;
+	sjtu::priority_queue<int, std::less<int>, true> lazy[4];
+	sjtu::priority_queue<int> eager[4];
+	int mismatches = 0;
+	long long sum = 0;
+	for (int step = 0; step < 100000; ++step) {
+		int op = Rand() % 100, i = Rand() % 4;
+		if (op < 70) {
+			int x = Rand() % 100000;
+			lazy[i].push(x);
+			eager[i].push(x);
+		} else if (op < 95) {
+			if (!eager[i].empty()) {
+				mismatches += lazy[i].top() != eager[i].top();
+				sum += lazy[i].top();
+				lazy[i].pop();
+				eager[i].pop();
+			}
+		} else {
+			int j = Rand() % 4;
+			lazy[i].merge(lazy[j]);
+			eager[i].merge(eager[j]);
+		}
+		mismatches += lazy[i].size() != eager[i].size();
+		mismatches += !lazy[i].empty() && lazy[i].top() != eager[i].top();
+	}
+	int same = 0;
+	for (int i = 0; i < 4; ++i) {
+		sjtu::priority_queue<int, std::less<int>, true> copy = lazy[i];
+		same += Same(copy, eager[i]);
+		same += Same(std::move(lazy[i]), eager[i]);
+		std::cout << eager[i].size() << " ";
+	}
+	std::cout << std::endl << sum << " " << mismatches << " " << same << std::endl;
+}
+
+void TestComparisons()
+{
+	std::cout << "Testing comparison counts..." << std::endl;
+	sjtu::priority_queue<int, Budget, true> a, b;
+	Budget::made = 0;
+	for (int i = 0; i < 100000; ++i) {
+		a.push(Rand());
+		b.push(Rand());
+	}
+	a.merge(b);
+	std::cout << "push and merge: " << Budget::made << std::endl;
+	Budget::made = 0;
+	a.pop();
+	std::cout << "first pop: " << Budget::made << " " << a.size() << std::endl;
+	Budget::made = 0;
+	for (int i = 0; i < 10; ++i) {
+		a.pop();
+	}
+	std::cout << "next ten pops: " << Budget::made << " " << a.top() << std::endl;
+}
+
+void TestRollback()
+{
+	std::cout << "Testing a throwing comparator..." << std::endl;
+	sjtu::priority_queue<int, Budget, true> q;
+	sjtu::priority_queue<int> expect;
+	for (int i = 0; i < 300; ++i) {
+		int x = Rand() % 1000;
+		q.push(x);
+		expect.push(x);
+	}
+	int caught = 0, unchanged = 0;
+	for (int budget = 0; budget < 90; ++budget) {
+		sjtu::priority_queue<int, Budget, true> other;
+		sjtu::priority_queue<int> other_expect;
+		for (int i = 0; i < 5; ++i) {
+			int x = Rand() % 2000;
+			other.push(x);
+			other_expect.push(x);
+		}
+		Budget::budget = budget / 3;
+		try {
+			if (budget % 3 == 0) {
+				int x = Rand() % 2000;
+				q.push(x);
+				expect.push(x);
+			} else if (budget % 3 == 1) {
+				q.pop();
+				expect.pop();
+			} else {
+				q.merge(other);
+				expect.merge(other_expect);
+			}
+		} catch (const sjtu::runtime_error &) {
+			Budget::budget = -1;
+			++caught;
+			unchanged += Same(q, expect);
+		}
+		Budget::budget = -1;
+		// a burst of pushes so that every pop has a long root list to consolidate
+		for (int i = 0; i < 20; ++i) {
+			int x = Rand() % 1000;
+			q.push(x);
+			expect.push(x);
+		}
+	}
+	std::cout << "caught " << caught << ", unchanged " << unchanged << ", size " << q.size() << std::endl;
+	std::cout << (Same(q, expect) ? "same elements" : "different elements") << std::endl;
+}
+
+template<bool Lazy>
+void TestForeignException()
+{
+	std::cout << "Testing a comparator throwing something else" << (Lazy ? " in lazy mode" : "") << "..." << std::endl;
+	sjtu::priority_queue<int, Foreign, Lazy> q;
+	sjtu::priority_queue<int> expect;
+	for (int i = 0; i < 200; ++i) {
+		int x = Rand() % 1000;
+		q.push(x);
+		expect.push(x);
+	}
+	int caught = 0, foreign = 0, unchanged = 0;
+	for (int budget = 0; budget < 100; ++budget) {
+		sjtu::priority_queue<int, Foreign, Lazy> other;
+		sjtu::priority_queue<int> other_expect;
+		sjtu::vector<int> range;
+		for (int i = 0; i < 5; ++i) {
+			int x = Rand() % 2000;
+			other.push(x);
+			other_expect.push(x);
+			range.push_back(Rand() % 2000);
+		}
+		Foreign::budget = budget / 5;
+		try {
+			if (budget % 5 == 0) {
+				int x = Rand() % 2000;
+				q.push(x);
+				expect.push(x);
+			} else if (budget % 5 == 1) {
+				q.pop();
+				expect.pop();
+			} else if (budget % 5 == 2) {
+				q.merge(other);
+				expect.merge(other_expect);
+			} else if (budget % 5 == 3) {
+				q.push_range(range);
+				expect.push_range(range);
+			} else {
+				sjtu::priority_queue<int, Foreign, Lazy> copy = q;
+				sjtu::vector<int> out;
+				copy.drain_sorted(out);
+			}
+		} catch (const sjtu::runtime_error &) {
+			Foreign::budget = -1;
+			++caught;
+			unchanged += Same(q, expect);
+		} catch (...) {
+			++foreign;
+		}
+		Foreign::budget = -1;
+	}
+	std::cout << "caught " << caught << ", foreign " << foreign << ", unchanged " << unchanged << std::endl;
+	std::cout << (Same(q, expect) ? "same elements" : "different elements") << std::endl;
+}
+
+int main()
+{
+	TestAgainstEager();
+	TestComparisons();
+	TestRollback();
+	TestForeignException<false>();
+	TestForeignException<true>();
+	return 0;
+}
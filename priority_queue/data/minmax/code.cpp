@@ -0,0 +1,253 @@
+#include <iostream>
+#include <string>
+#include "minmax_heap.hpp"
+
+int A = 325, B = 2336, last = 233, mod = 1000007;
+
+int Rand(){
+	return last = (A * last + B) % mod;
+}
+
+// throws once budget comparisons have been made, if budget is not negative
+struct Budget {
+	static int budget;
+	bool operator()(int a, int b) const {
+		if (budget == 0) {
+			throw sjtu::runtime_error();
+		}
+		if (budget > 0) {
+			--budget;
+		}
+		return a < b;
+	}
+};
+int Budget::budget = -1;
+
+// like Budget, but throws an int and its call is not const
+struct Foreign {
+	static int budget;
+	bool operator()(int a, int b) {
+		if (budget == 0) {
+			throw 42;
+		}
+		if (budget > 0) {
+			--budget;
+		}
+		return a < b;
+	}
+};
+int Foreign::budget = -1;
+
+// a sorted array as the reference, inserting in place
+void Insert(sjtu::vector<int> &v, int x)
+{
+	size_t i = v.size();
+	v.push_back(x);
+	for (; i > 0 && v[i - 1] > x; --i) {
+		v[i] = v[i - 1];
+	}
+	v[i] = x;
+}
+
+void EraseFront(sjtu::vector<int> &v)
+{
+	for (size_t i = 1; i < v.size(); ++i) {
+		v[i - 1] = v[i];
+	}
+	v.pop_back();
+}
+
+template<class Compare>
+bool SameAs(sjtu::minmax_heap<int, Compare> h, sjtu::vector<int> v)
+{
+	bool same = h.size() == v.size();
+	for (size_t i = 0; same && !h.empty(); ++i) {
+		if (i % 2 == 0) {
+			same = h.min() == v[0];
+			h.pop_min();
+			EraseFront(v);
+		} else {
+			same = h.max() == v.back();
+			h.pop_max();
+			v.pop_back();
+		}
+	}
+	return same;
+}
+
+void TestAgainstSorted()
+{
+	std::cout << "Testing against a sorted array..." << std::endl;
+	sjtu::minmax_heap<int> h;
+	sjtu::vector<int> v;
+	long long sum = 0;
+	bool same = true;
+	for (int i = 0; i < 60000; ++i) {
+		int op = Rand() % 5;
+		if (op < 3 || v.empty()) {
+			int x = Rand() % 3000;
+			h.push(x);
+			Insert(v, x);
+		} else if (op == 3) {
+			same = same && h.min() == v[0];
+			sum += h.min();
+			h.pop_min();
+			EraseFront(v);
+		} else {
+			same = same && h.max() == v.back();
+			sum += h.max();
+			h.pop_max();
+			v.pop_back();
+		}
+	}
+	std::cout << h.size() << " " << v.size() << " " << sum << std::endl;
+	std::cout << (same && SameAs(h, v) ? "same order" : "different order") << std::endl;
+}
+
+void TestBuild()
+{
+	std::cout << "Testing bulk construction..." << std::endl;
+	for (size_t n : {0, 1, 2, 3, 4, 7, 8, 31, 100, 1000, 5000}) {
+		sjtu::vector<int> input, sorted;
+		for (size_t i = 0; i < n; ++i) {
+			int x = Rand() % 1000;
+			input.push_back(x);
+			Insert(sorted, x);
+		}
+		sjtu::minmax_heap<int> a(input), b(input.begin(), input.end());
+		sjtu::minmax_heap<int, std::greater<int>> c(input);
+		bool same = SameAs(a, sorted) && SameAs(b, sorted);
+		same = same && c.size() == n && (n == 0 || (c.min() == sorted.back() && c.max() == sorted[0]));
+		std::cout << n << ": " << (same ? "same" : "different") << std::endl;
+	}
+}
+
+void TestRollback()
+{
+	std::cout << "Testing a throwing comparator..." << std::endl;
+	sjtu::minmax_heap<int, Budget> h;
+	for (int i = 0; i < 500; ++i) {
+		h.push(Rand() % 1000);
+	}
+	int caught = 0, unchanged = 0;
+	for (int budget = 0; budget < 60; ++budget) {
+		sjtu::minmax_heap<int, Budget> before = h;
+		Budget::budget = budget;
+		try {
+			if (budget % 3 == 0) {
+				h.push(Rand() % 2000);
+			} else if (budget % 3 == 1) {
+				h.pop_min();
+			} else {
+				h.pop_max();
+			}
+		} catch (const sjtu::runtime_error &) {
+			Budget::budget = -1;
+			++caught;
+			sjtu::minmax_heap<int, Budget> after = h;
+			bool same = after.size() == before.size();
+			while (same && !after.empty()) {
+				same = after.min() == before.min();
+				after.pop_min();
+				before.pop_min();
+			}
+			unchanged += same;
+		}
+		Budget::budget = -1;
+	}
+	std::cout << "caught " << caught << ", unchanged " << unchanged << ", size " << h.size() << std::endl;
+	int prev = h.max(), sorted = 1;
+	while (!h.empty()) {
+		sorted &= h.max() <= prev;
+		prev = h.max();
+		h.pop_max();
+	}
+	std::cout << (sorted ? "still a heap" : "broken") << std::endl;
+}
+
+void TestForeignException()
+{
+	std::cout << "Testing a comparator throwing something else..." << std::endl;
+	sjtu::vector<int> input;
+	sjtu::minmax_heap<int, Foreign> h;
+	for (int i = 0; i < 300; ++i) {
+		input.push_back(Rand() % 1000);
+		h.push(input.back());
+	}
+	int caught = 0, foreign = 0;
+	for (int budget = 0; budget < 80; ++budget) {
+		Foreign::budget = budget / 4;
+		try {
+			if (budget % 4 == 0) {
+				h.push(Rand() % 2000);
+			} else if (budget % 4 == 1) {
+				h.pop_min();
+			} else if (budget % 4 == 2) {
+				h.pop_max();
+			} else {
+				sjtu::minmax_heap<int, Foreign> built(input);
+			}
+		} catch (const sjtu::runtime_error &) {
+			++caught;
+		} catch (...) {
+			++foreign;
+		}
+		Foreign::budget = 0;
+		try {
+			h.max();
+		} catch (const sjtu::runtime_error &) {
+			++caught;
+		} catch (...) {
+			++foreign;
+		}
+		Foreign::budget = -1;
+	}
+	std::cout << "caught " << caught << ", foreign " << foreign << ", size " << h.size() << ", max " << h.max() << std::endl;
+}
+
+void TestCopyAndMove()
+{
+	std::cout << "Testing copies and moves..." << std::endl;
+	sjtu::minmax_heap<std::string> a;
+	try {
+		a.min();
+	} catch (const sjtu::container_is_empty &) {
+		std::cout << "empty min" << std::endl;
+	}
+	try {
+		a.max();
+	} catch (const sjtu::container_is_empty &) {
+		std::cout << "empty max" << std::endl;
+	}
+	try {
+		a.pop_min();
+	} catch (const sjtu::container_is_empty &) {
+		std::cout << "empty pop_min" << std::endl;
+	}
+	try {
+		a.pop_max();
+	} catch (const sjtu::container_is_empty &) {
+		std::cout << "empty pop_max" << std::endl;
+	}
+	for (int i = 0; i < 50; ++i) {
+		a.push(std::to_string(Rand()));
+	}
+	sjtu::minmax_heap<std::string> b = a;
+	sjtu::minmax_heap<std::string> c(std::move(a));
+	std::cout << a.size() << " " << b.size() << " " << c.size() << " " << c.min() << " " << c.max() << std::endl;
+	b.pop_min();
+	b.pop_max();
+	a = b;
+	c = std::move(b);
+	std::cout << a.size() << " " << b.size() << " " << c.size() << " " << a.min() << " " << c.max() << std::endl;
+}
+
+int main()
+{
+	TestAgainstSorted();
+	TestBuild();
+	TestRollback();
+	TestCopyAndMove();
+	TestForeignException();
+	return 0;
+}
@@ -0,0 +1,130 @@
+#include <iostream>
+#include <string>
+#include "priority_queue.hpp"
+
+int A = 325, B = 2336, last = 233, mod = 1000007;
+
+int Rand(){
+	return last = (A * last + B) % mod;
+}
+
+// move-only, counts how often it is moved
+class Ticket {
+public:
+	static int moves;
+	static bool fail; // makes every comparison throw
+	Ticket(int priority, std::string name) : priority_(priority), name_(std::move(name)) {}
+	Ticket(const Ticket &) = delete;
+	Ticket &operator=(const Ticket &) = delete;
+	Ticket(Ticket &&other) noexcept : priority_(other.priority_), name_(std::move(other.name_)) {
+		++moves;
+	}
+	Ticket &operator=(Ticket &&other) noexcept {
+		priority_ = other.priority_;
+		name_ = std::move(other.name_);
+		++moves;
+		return *this;
+	}
+	bool operator<(const Ticket &rhs) const {
+		if (fail) {
+			throw sjtu::runtime_error();
+		}
+		return priority_ < rhs.priority_;
+	}
+	int priority() const {
+		return priority_;
+	}
+	const std::string &name() const {
+		return name_;
+	}
+private:
+	int priority_;
+	std::string name_;
+};
+int Ticket::moves = 0;
+bool Ticket::fail = false;
+
+void TestMoveOnly()
+{
+	std::cout << "Testing move-only elements..." << std::endl;
+	sjtu::priority_queue<Ticket> q;
+	for (int i = 0; i < 20; ++i) {
+		if (i % 2 == 0) {
+			q.push(Ticket(Rand() % 100, "push" + std::to_string(i)));
+		} else {
+			q.emplace(Rand() % 100, "emplace" + std::to_string(i));
+		}
+	}
+	std::cout << "moves after 20 inserts: " << Ticket::moves << std::endl;
+	Ticket::moves = 0;
+	sjtu::priority_queue<Ticket> other;
+	for (int i = 0; i < 15; ++i) {
+		other.emplace(Rand() % 100, "other" + std::to_string(i));
+	}
+	q.merge(other);
+	std::cout << "moves during merge: " << Ticket::moves << " " << q.size() << " " << other.size() << std::endl;
+	while (q.size() > 10) {
+		Ticket t = q.pop_value();
+		std::cout << t.priority() << ":" << t.name() << " ";
+	}
+	std::cout << std::endl;
+}
+
+void TestPopValueRollback()
+{
+	std::cout << "Testing pop_value with a throwing comparator..." << std::endl;
+	sjtu::priority_queue<Ticket> q;
+	for (int i = 0; i < 37; ++i) {
+		q.emplace(i * 7 % 37, "t" + std::to_string(i));
+	}
+	Ticket::fail = true;
+	try {
+		q.pop_value();
+		std::cout << "no exception" << std::endl;
+	} catch (const sjtu::runtime_error &) {
+		std::cout << "caught, size " << q.size() << ", top " << q.top().priority() << ":" << q.top().name() << std::endl;
+	}
+	try {
+		q.push(Ticket(100, "late"));
+		std::cout << "no exception" << std::endl;
+	} catch (const sjtu::runtime_error &) {
+		std::cout << "caught, size " << q.size() << std::endl;
+	}
+	Ticket::fail = false;
+	while (!q.empty()) {
+		std::cout << q.pop_value().priority() << " ";
+	}
+	std::cout << std::endl;
+}
+
+void TestContainerMoves()
+{
+	std::cout << "Testing moving queues..." << std::endl;
+	sjtu::priority_queue<int> a;
+	for (int i = 0; i < 1000; ++i) {
+		a.push(Rand());
+	}
+	sjtu::priority_queue<int> b(std::move(a));
+	std::cout << a.size() << " " << b.size() << " " << b.top() << std::endl;
+	// a moved-from queue is empty and usable
+	a.push(5);
+	a.push(7);
+	std::cout << a.top() << " " << a.size() << std::endl;
+	a = std::move(b);
+	std::cout << a.size() << " " << b.size() << " " << a.pop_value() << " " << a.top() << std::endl;
+	b.push(1);
+	b = std::move(b);
+	b.merge(a);
+	std::cout << a.size() << " " << b.size() << " " << b.top() << std::endl;
+	sjtu::priority_queue<int> c = b;
+	b = sjtu::priority_queue<int>();
+	std::cout << b.size() << " " << c.size() << " " << c.top() << std::endl;
+}
+
+int main()
+{
+	TestMoveOnly();
+	TestPopValueRollback();
+	TestContainerMoves();
+	return 0;
+}
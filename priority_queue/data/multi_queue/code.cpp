@@ -0,0 +1,130 @@
+#include "multi_queue.hpp"
+#include "priority_queue.hpp"
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+const int kThreads = 8, kPerThread = 50000;
+
+// every element pushed by the producers is popped exactly once by the consumers
+void TestProducersConsumers()
+{
+	std::cout << "Testing concurrent push and try_pop..." << std::endl;
+	sjtu::multi_queue<long long> q(kThreads);
+	std::vector<std::atomic<int>> seen(kThreads * kPerThread);
+	std::atomic<int> producing(kThreads / 2);
+	std::atomic<long long> popped(0);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < kThreads / 2; ++t) {
+		threads.emplace_back([&, t] {
+			for (int i = 0; i < kPerThread * 2; ++i) {
+				q.push(static_cast<long long>(t) * kPerThread * 2 + i);
+			}
+			--producing;
+		});
+		threads.emplace_back([&] {
+			long long x;
+			while (true) {
+				if (q.try_pop(x)) {
+					++seen[x];
+					++popped;
+				} else if (producing.load() == 0 && q.empty()) {
+					break;
+				}
+			}
+		});
+	}
+	for (std::thread &t : threads) {
+		t.join();
+	}
+	int once = 0;
+	for (auto &s : seen) {
+		once += s.load() == 1;
+	}
+	std::cout << popped.load() << " " << once << " " << q.size() << " " << q.heaps() << std::endl;
+}
+
+// on one thread, the popped elements are nearly sorted: how far each one is from the best
+void TestRelaxation()
+{
+	std::cout << "Testing relaxation..." << std::endl;
+	const int n = 20000;
+	sjtu::multi_queue<int, std::greater<int>> q(4);
+	for (int i = 0; i < n; ++i) {
+		q.push((i * 7919) % n);
+	}
+	std::vector<bool> gone(n);
+	int x, smallest = 0, worst = 0, in_order = 1;
+	long long total = 0;
+	for (int i = 0; i < n; ++i) {
+		if (!q.try_pop(x)) {
+			in_order = 0;
+			break;
+		}
+		gone[x] = true;
+		int rank = 0;
+		for (int k = smallest; k < x; ++k) {
+			rank += !gone[k];
+		}
+		total += rank;
+		worst = rank > worst ? rank : worst;
+		while (smallest < n && gone[smallest]) {
+			++smallest;
+		}
+	}
+	std::cout << (in_order && !q.try_pop(x) ? "all popped" : "missing") << " "
+	          << (total < 10LL * n ? "small mean rank error" : "large mean rank error") << " "
+	          << (worst < 200 ? "small max rank error" : "large max rank error") << std::endl;
+}
+
+// a comparator that throws leaves every element in the queue
+struct Faulty {
+	static std::atomic<bool> fail;
+	bool operator()(int a, int b) const {
+		if (fail.load()) {
+			throw sjtu::runtime_error();
+		}
+		return a < b;
+	}
+};
+std::atomic<bool> Faulty::fail(false);
+
+void TestExceptions()
+{
+	std::cout << "Testing a throwing comparator..." << std::endl;
+	sjtu::multi_queue<int, Faulty> q(2);
+	for (int i = 0; i < 1000; ++i) {
+		q.push(i);
+	}
+	Faulty::fail = true;
+	int caught = 0, x;
+	for (int i = 0; i < 100; ++i) {
+		try {
+			if (i % 2 == 0) {
+				q.push(5000 + i);
+			} else {
+				q.try_pop(x);
+			}
+		} catch (const sjtu::runtime_error &) {
+			++caught;
+		}
+	}
+	Faulty::fail = false;
+	long long sum = 0;
+	int count = 0;
+	while (q.try_pop(x)) {
+		sum += x;
+		++count;
+	}
+	std::cout << caught << " " << count << " " << sum << std::endl;
+}
+
+int main()
+{
+	TestProducersConsumers();
+	TestRelaxation();
+	TestExceptions();
+	return 0;
+}
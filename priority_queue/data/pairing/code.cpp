@@ -0,0 +1,249 @@
+#include <iostream>
+#include <string>
+#include "pairing_heap.hpp"
+#include "priority_queue.hpp"
+
+int A = 325, B = 2336, last = 233, mod = 1000007;
+
+int Rand(){
+	return last = (A * last + B) % mod;
+}
+
+// throws once budget comparisons have been made, if budget is not negative
+struct Budget {
+	static int budget;
+	bool operator()(int a, int b) const {
+		if (budget == 0) {
+			throw sjtu::runtime_error();
+		}
+		if (budget > 0) {
+			--budget;
+		}
+		return a < b;
+	}
+};
+int Budget::budget = -1;
+
+const int N = 8000;
+
+// every operation is checked against a plain array of the live keys
+void TestHandles()
+{
+	std::cout << "Testing handles..." << std::endl;
+	sjtu::pairing_heap<int> h;
+	sjtu::pairing_heap<int>::handle handles[N];
+	int key[N];
+	bool alive[N] = {};
+	int pushed = 0, live = 0, mismatches = 0;
+	long long sum = 0;
+	for (int step = 0; step < 20000; ++step) {
+		int op = Rand() % 7;
+		if (op <= 2 && pushed < N) {
+			key[pushed] = Rand() % 10000;
+			handles[pushed] = h.push(key[pushed]);
+			alive[pushed++] = true;
+			++live;
+		} else if (op == 3 && live > 0) {
+			int best = -1;
+			for (int i = 0; i < pushed; ++i) {
+				if (alive[i] && (best == -1 || key[i] > key[best])) {
+					best = i;
+				}
+			}
+			mismatches += h.top() != key[best];
+			sum += h.top();
+			int who = -1;
+			for (int i = 0; i < pushed; ++i) {
+				if (alive[i] && handles[i] == h.top_handle()) {
+					who = i;
+				}
+			}
+			alive[who] = false;
+			--live;
+			h.pop();
+		} else if (op >= 4 && live > 0) {
+			int i = Rand() % pushed;
+			while (!alive[i]) {
+				i = (i + 1) % pushed;
+			}
+			if (op == 4) {
+				key[i] += Rand() % 500;
+				h.increase_key(handles[i], key[i]);
+			} else if (op == 5) {
+				key[i] -= Rand() % 500;
+				h.decrease_key(handles[i], key[i]);
+			} else if (Rand() % 2 == 0) {
+				key[i] = Rand() % 10000;
+				h.update(handles[i], key[i]);
+			} else {
+				h.erase(handles[i]);
+				alive[i] = false;
+				--live;
+			}
+			mismatches += alive[i] && h.value(handles[i]) != key[i];
+		}
+		mismatches += h.size() != (size_t)live;
+	}
+	std::cout << h.size() << " " << sum << " " << mismatches << std::endl;
+	int prev = h.top(), sorted = 1;
+	while (!h.empty()) {
+		sorted &= h.top() <= prev;
+		prev = h.pop_value();
+	}
+	std::cout << (sorted ? "sorted" : "not sorted") << std::endl;
+}
+
+// shortest paths on a random graph, once with decrease-key and once with lazy duplicates
+void TestDijkstra()
+{
+	std::cout << "Testing Dijkstra..." << std::endl;
+	const int V = 2000, E = 12000;
+	static int head[V], nxt[E], to[E], w[E];
+	for (int i = 0; i < V; ++i) {
+		head[i] = -1;
+	}
+	for (int e = 0; e < E; ++e) {
+		int u = Rand() % V;
+		to[e] = Rand() % V;
+		w[e] = Rand() % 1000 + 1;
+		nxt[e] = head[u];
+		head[u] = e;
+	}
+	struct item {
+		long long dist;
+		int v;
+		bool operator>(const item &rhs) const {
+			return dist > rhs.dist;
+		}
+	};
+	static long long dist[V], lazy[V];
+	static sjtu::pairing_heap<item, std::greater<item>>::handle where[V];
+	static bool queued[V];
+	for (int i = 0; i < V; ++i) {
+		dist[i] = lazy[i] = -1;
+	}
+	sjtu::pairing_heap<item, std::greater<item>> h;
+	dist[0] = 0;
+	where[0] = h.push({0, 0});
+	queued[0] = true;
+	size_t largest = 0;
+	while (!h.empty()) {
+		largest = h.size() > largest ? h.size() : largest;
+		item cur = h.pop_value();
+		queued[cur.v] = false;
+		for (int e = head[cur.v]; e != -1; e = nxt[e]) {
+			long long d = cur.dist + w[e];
+			if (dist[to[e]] == -1) {
+				dist[to[e]] = d;
+				where[to[e]] = h.push({d, to[e]});
+				queued[to[e]] = true;
+			} else if (d < dist[to[e]] && queued[to[e]]) {
+				dist[to[e]] = d;
+				h.increase_key(where[to[e]], {d, to[e]});
+			}
+		}
+	}
+	sjtu::priority_queue<item, std::greater<item>> q;
+	lazy[0] = 0;
+	q.push({0, 0});
+	while (!q.empty()) {
+		item cur = q.top();
+		q.pop();
+		if (cur.dist != lazy[cur.v]) {
+			continue;
+		}
+		for (int e = head[cur.v]; e != -1; e = nxt[e]) {
+			long long d = cur.dist + w[e];
+			if (lazy[to[e]] == -1 || d < lazy[to[e]]) {
+				lazy[to[e]] = d;
+				q.push({d, to[e]});
+			}
+		}
+	}
+	int same = 0;
+	long long total = 0;
+	for (int i = 0; i < V; ++i) {
+		same += dist[i] == lazy[i];
+		total += dist[i];
+	}
+	std::cout << same << " " << total << " " << largest << std::endl;
+}
+
+// a failed operation must leave exactly the same elements behind
+void TestRollback()
+{
+	std::cout << "Testing a throwing comparator..." << std::endl;
+	sjtu::pairing_heap<int, Budget> h;
+	for (int i = 0; i < 300; ++i) {
+		h.push(Rand() % 1000);
+	}
+	h.pop(); // now the root has a long list of children to combine
+	int caught = 0, unchanged = 0;
+	for (int budget = 0; budget < 60; ++budget) {
+		sjtu::pairing_heap<int, Budget>::handle any = h.push(Rand() % 1000);
+		sjtu::pairing_heap<int, Budget> before = h;
+		sjtu::pairing_heap<int, Budget> other;
+		other.push(Rand() % 2000);
+		other.push(Rand() % 2000);
+		Budget::budget = budget / 6;
+		try {
+			switch (budget % 6) {
+				case 0: h.push(Rand() % 2000); break;
+				case 1: h.pop(); break;
+				case 2: h.increase_key(any, h.value(any) + 600); break;
+				case 3: h.decrease_key(h.top_handle(), h.top() - 5); break;
+				case 4: h.merge(other); break;
+				case 5: h.erase(any); break;
+			}
+		} catch (const sjtu::runtime_error &) {
+			Budget::budget = -1;
+			++caught;
+			sjtu::pairing_heap<int, Budget> after = h;
+			bool same = after.size() == before.size();
+			while (same && !after.empty()) {
+				same = after.pop_value() == before.pop_value();
+			}
+			unchanged += same;
+		}
+		Budget::budget = -1;
+	}
+	std::cout << "caught " << caught << ", unchanged " << unchanged << ", size " << h.size() << std::endl;
+}
+
+void TestMerge()
+{
+	std::cout << "Testing merge..." << std::endl;
+	sjtu::pairing_heap<std::string> a, b;
+	sjtu::pairing_heap<std::string>::handle hb[20];
+	for (int i = 0; i < 20; ++i) {
+		a.push("a" + std::to_string(Rand() % 100));
+		hb[i] = b.push("b" + std::to_string(Rand() % 100));
+	}
+	a.merge(b);
+	std::cout << a.size() << " " << b.size() << " " << a.top() << std::endl;
+	a.increase_key(hb[3], "zz");
+	a.erase(hb[5]);
+	std::cout << a.size() << " " << a.top() << std::endl;
+	sjtu::pairing_heap<std::string> c(std::move(a));
+	c.merge(a);
+	a.merge(c);
+	std::cout << a.size() << " " << c.size() << std::endl;
+	while (a.size() > 30) {
+		std::cout << a.pop_value() << " ";
+	}
+	std::cout << std::endl;
+	try {
+		c.pop();
+	} catch (const sjtu::container_is_empty &) {
+		std::cout << "empty pop" << std::endl;
+	}
+}
+
+int main()
+{
+	TestHandles();
+	TestDijkstra();
+	TestRollback();
+	TestMerge();
+	return 0;
+}
@@ -0,0 +1,108 @@
+#include <iostream>
+#include <string>
+#include "priority_queue.hpp"
+
+int A = 325, B = 2336, last = 233, mod = 1000007;
+
+int Rand(){
+	return last = (A * last + B) % mod;
+}
+
+template<typename T>
+void Drain(sjtu::priority_queue<T> &q, int count)
+{
+	for (int i = 0; i < count && !q.empty(); ++i) {
+		std::cout << q.top() << " ";
+		q.pop();
+	}
+	std::cout << "| " << q.size() << std::endl;
+}
+
+void TestReserve()
+{
+	std::cout << "Testing reserve..." << std::endl;
+	sjtu::priority_queue<int> q;
+	q.reserve(1000);
+	for (int i = 0; i < 1000; ++i) {
+		q.push(Rand());
+	}
+	Drain(q, 5);
+	// popped nodes are reused
+	for (int i = 0; i < 500; ++i) {
+		q.pop();
+		q.push(Rand());
+	}
+	Drain(q, 5);
+	sjtu::priority_queue<int> copy = q;
+	q = copy;
+	Drain(copy, 5);
+	Drain(q, 5);
+}
+
+void TestMerge()
+{
+	std::cout << "Testing merge of pools..." << std::endl;
+	sjtu::priority_queue<std::string> a, b;
+	for (int i = 0; i < 300; ++i) {
+		a.push("a" + std::to_string(Rand()) + std::string(20, '.'));
+		b.push("b" + std::to_string(Rand()) + std::string(20, '.'));
+	}
+	a.merge(b);
+	// b gave its slabs to a and keeps working on its own
+	for (int i = 0; i < 100; ++i) {
+		b.push("c" + std::to_string(Rand()));
+	}
+	Drain(a, 3);
+	Drain(b, 3);
+	a.merge(b);
+	Drain(a, 3);
+}
+
+void TestShare()
+{
+	std::cout << "Testing shared pool..." << std::endl;
+	sjtu::priority_queue<std::string> *c = new sjtu::priority_queue<std::string>;
+	sjtu::priority_queue<std::string> a, b;
+	b.share_pool(a);
+	c->share_pool(b);
+	for (int i = 0; i < 200; ++i) {
+		a.push(std::to_string(Rand()));
+		b.push(std::to_string(Rand()));
+		c->push(std::to_string(Rand()));
+	}
+	a.merge(*c);
+	delete c;
+	Drain(a, 3);
+	// d has nodes of its own when it starts sharing
+	sjtu::priority_queue<std::string> d;
+	for (int i = 0; i < 50; ++i) {
+		d.push(std::to_string(Rand()));
+	}
+	d.share_pool(b);
+	b.merge(d);
+	Drain(b, 3);
+	Drain(d, 3);
+	// e's pool is forwarded into a's when a takes its nodes, f still holds it
+	sjtu::priority_queue<std::string> e, f;
+	f.share_pool(e);
+	for (int i = 0; i < 100; ++i) {
+		e.push(std::to_string(Rand()));
+		f.push(std::to_string(Rand()));
+	}
+	a.merge(e);
+	for (int i = 0; i < 100; ++i) {
+		f.push(std::to_string(Rand()));
+		e.push(std::to_string(Rand()));
+	}
+	Drain(a, 3);
+	Drain(e, 3);
+	Drain(f, 3);
+}
+
+int main()
+{
+	TestReserve();
+	TestMerge();
+	TestShare();
+	return 0;
+}
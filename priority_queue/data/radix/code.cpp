@@ -0,0 +1,177 @@
+#include <iostream>
+#include <string>
+#include "radix_heap.hpp"
+#include "priority_queue.hpp"
+
+int A = 325, B = 2336, last = 233, mod = 1000007;
+
+int Rand(){
+	return last = (A * last + B) % mod;
+}
+
+// throws on the copy after the next budget copies, if budget is not negative; moves never throw
+struct Payload {
+	static int budget;
+	std::string text;
+	Payload(std::string t) : text(std::move(t)) {}
+	Payload(const Payload &other) : text(other.text) {
+		if (budget == 0) {
+			throw sjtu::runtime_error();
+		}
+		if (budget > 0) {
+			--budget;
+		}
+	}
+	Payload(Payload &&other) noexcept = default;
+	Payload &operator=(const Payload &other) = default;
+	Payload &operator=(Payload &&other) noexcept = default;
+};
+int Payload::budget = -1;
+
+struct Event {
+	unsigned time;
+	int id;
+	bool operator>(const Event &rhs) const {
+		return time > rhs.time || (time == rhs.time && id > rhs.id);
+	}
+};
+
+// an event simulation: every popped event schedules a few later ones
+void TestAgainstBinomial()
+{
+	std::cout << "Testing against the binomial heap..." << std::endl;
+	sjtu::radix_heap<unsigned, int> h;
+	sjtu::priority_queue<Event, std::greater<Event>> q;
+	int ids = 0, mismatches = 0;
+	long long sum = 0;
+	for (int i = 0; i < 100; ++i) {
+		unsigned t = Rand() % 1000;
+		h.push(t, ids);
+		q.push({t, ids++});
+	}
+	while (!q.empty() && ids < 300000) {
+		Event e = q.top();
+		q.pop();
+		mismatches += h.top().first != e.time;
+		unsigned now = h.top().first;
+		sum += h.top().second % 7;
+		h.pop();
+		int spawn = Rand() % 3;
+		for (int k = 0; k < spawn; ++k) {
+			int bits = Rand() % 20;
+			unsigned t = now + (k == 0 ? 0 : Rand() % (1 << bits));
+			h.push(t, ids);
+			q.push({t, ids++});
+		}
+		mismatches += h.size() != q.size();
+	}
+	std::cout << h.size() << " " << ids << " " << sum << " " << mismatches << std::endl;
+}
+
+void TestExceptions()
+{
+	std::cout << "Testing exceptions..." << std::endl;
+	sjtu::radix_heap<unsigned long long, Payload> h;
+	try {
+		h.top();
+	} catch (const sjtu::container_is_empty &) {
+		std::cout << "empty top" << std::endl;
+	}
+	try {
+		h.pop();
+	} catch (const sjtu::container_is_empty &) {
+		std::cout << "empty pop" << std::endl;
+	}
+	for (int i = 0; i < 200; ++i) {
+		h.push(1000 + Rand() % 100000, Payload("p" + std::to_string(i)));
+	}
+	std::cout << h.top().first << " " << h.top().second.text << std::endl;
+	try {
+		h.push(999, Payload("early"));
+	} catch (const sjtu::runtime_error &) {
+		std::cout << "key below top, size " << h.size() << std::endl;
+	}
+	h.push(h.top().first, Payload("same"));
+	h.pop();
+	h.pop();
+	int caught = 0;
+	for (int budget = 0; budget < 300; budget += 7) {
+		sjtu::radix_heap<unsigned long long, Payload> copy = h;
+		Payload::budget = budget;
+		try {
+			while (!h.empty()) {
+				h.pop();
+				h.top();
+			}
+		} catch (const sjtu::runtime_error &) {
+			++caught;
+		}
+		Payload::budget = -1;
+		sjtu::radix_heap<unsigned long long, Payload> back = h;
+		h = std::move(copy);
+		(void)back;
+	}
+	std::cout << "caught " << caught << std::endl;
+	std::string order;
+	unsigned long long prev = 0;
+	bool sorted = true;
+	while (!h.empty()) {
+		sorted = sorted && h.top().first >= prev;
+		prev = h.top().first;
+		if (h.size() % 40 == 0) {
+			order += h.top().second.text + " ";
+		}
+		h.pop();
+	}
+	std::cout << (sorted ? "sorted" : "not sorted") << " " << order << std::endl;
+}
+
+// after a failed refill, the heap still holds the same keys
+void TestRollback()
+{
+	std::cout << "Testing a throwing copy..." << std::endl;
+	int caught = 0, unchanged = 0;
+	for (int budget = 0; budget < 60; ++budget) {
+		sjtu::radix_heap<unsigned, Payload> h;
+		for (int i = 0; i < 50; ++i) {
+			h.push(Rand() % 5000, Payload("x"));
+		}
+		h.pop();
+		for (int i = 0; i < 10; ++i) {
+			h.push(h.top().first + Rand() % 100, Payload("y"));
+		}
+		sjtu::radix_heap<unsigned, Payload> before = h;
+		Payload::budget = budget;
+		try {
+			for (int i = 0; i < 5; ++i) {
+				h.pop();
+				h.top();
+			}
+			Payload::budget = -1;
+			continue;
+		} catch (const sjtu::runtime_error &) {
+			Payload::budget = -1;
+			++caught;
+		}
+		// the pops made before the exception took out the smallest keys of before
+		bool same = true;
+		while (before.size() > h.size()) {
+			before.pop();
+		}
+		while (same && !h.empty()) {
+			same = h.top().first == before.top().first;
+			h.pop();
+			before.pop();
+		}
+		unchanged += same;
+	}
+	std::cout << "caught " << caught << ", unchanged " << unchanged << std::endl;
+}
+
+int main()
+{
+	TestAgainstBinomial();
+	TestExceptions();
+	TestRollback();
+	return 0;
+}
@@ -0,0 +1,259 @@
+#include <iostream>
+#include <string>
+#include "top_k.hpp"
+#include "priority_queue.hpp"
+
+int A = 325, B = 2336, last = 233, mod = 1000007;
+
+int Rand(){
+	return last = (A * last + B) % mod;
+}
+
+// throws once budget comparisons have been made, if budget is not negative
+struct Budget {
+	static int budget;
+	bool operator()(int a, int b) const {
+		if (budget == 0) {
+			throw sjtu::runtime_error();
+		}
+		if (budget > 0) {
+			--budget;
+		}
+		return a < b;
+	}
+};
+int Budget::budget = -1;
+
+// the k largest of all pushed so far, from a priority_queue holding everything
+template<class Compare>
+bool SameAsQueue(sjtu::top_k<int, Compare> t, sjtu::priority_queue<int, Compare> q)
+{
+	sjtu::vector<int> out;
+	t.drain_sorted(out);
+	bool same = t.empty();
+	for (size_t i = 0; i < out.size() && same; ++i) {
+		same = !q.empty() && q.top() == out[i];
+		q.pop();
+	}
+	return same;
+}
+
+void TestAgainstQueue()
+{
+	std::cout << "Testing against priority_queue..." << std::endl;
+	for (size_t k : {0, 1, 2, 7, 100, 1000}) {
+		sjtu::top_k<int> t(k);
+		sjtu::priority_queue<int> q;
+		int kept = 0;
+		bool same = true;
+		for (int i = 0; i < 20000; ++i) {
+			int x = Rand() % 50000;
+			kept += t.push(x);
+			q.push(x);
+			if (i % 997 == 0) {
+				same = same && SameAsQueue(t, q);
+			}
+		}
+		same = same && SameAsQueue(t, q);
+		std::cout << k << ": size " << t.size() << ", kept " << kept << ", "
+			<< (t.full() ? "full" : "not full") << ", " << (same ? "same" : "different") << std::endl;
+		if (!t.empty()) {
+			std::cout << "threshold " << t.threshold() << std::endl;
+		}
+	}
+}
+
+void TestMerge()
+{
+	std::cout << "Testing merge..." << std::endl;
+	sjtu::top_k<int, std::greater<int>> a(50), b(50);
+	sjtu::priority_queue<int, std::greater<int>> q;
+	for (int i = 0; i < 3000; ++i) {
+		int x = Rand() % 100000;
+		if (i % 3 == 0) {
+			a.push(x);
+		} else {
+			b.push(x);
+		}
+		q.push(x);
+	}
+	a.merge(b);
+	a.merge(a);
+	std::cout << a.size() << " " << b.size() << " " << a.threshold() << " "
+		<< (SameAsQueue(a, q) ? "same" : "different") << std::endl;
+	sjtu::top_k<int, std::greater<int>> small(3);
+	small.merge(a);
+	long long sum = 0;
+	for (int x : small) {
+		sum += x;
+	}
+	std::cout << small.size() << " " << a.size() << " " << sum << std::endl;
+}
+
+void TestRollback()
+{
+	std::cout << "Testing a throwing comparator..." << std::endl;
+	sjtu::top_k<int, Budget> t(64), other(16);
+	for (int i = 0; i < 40; ++i) {
+		t.push(Rand() % 1000);
+	}
+	for (int i = 0; i < 16; ++i) {
+		other.push(Rand() % 1000);
+	}
+	int caught = 0, unchanged = 0;
+	for (int budget = 0; budget < 60; ++budget) {
+		sjtu::top_k<int, Budget> before = t, other_before = other;
+		Budget::budget = budget;
+		try {
+			if (budget % 3 == 2) {
+				t.merge(other);
+				other = other_before;
+			} else {
+				t.push(Rand() % 2000);
+			}
+		} catch (const sjtu::runtime_error &) {
+			Budget::budget = -1;
+			++caught;
+			sjtu::vector<int> x, y;
+			sjtu::top_k<int, Budget> copy = t;
+			copy.drain_sorted(x);
+			before.drain_sorted(y);
+			bool same = x.size() == y.size() && other.size() == other_before.size();
+			for (size_t i = 0; i < x.size() && same; ++i) {
+				same = x[i] == y[i];
+			}
+			unchanged += same;
+		}
+		Budget::budget = -1;
+	}
+	std::cout << "caught " << caught << ", unchanged " << unchanged << ", size " << t.size() << std::endl;
+	sjtu::vector<int> out;
+	t.drain_sorted(out);
+	bool sorted = true;
+	for (size_t i = 1; i < out.size(); ++i) {
+		sorted = sorted && out[i] <= out[i - 1];
+	}
+	std::cout << (sorted ? "still a heap" : "broken") << std::endl;
+}
+
+// copying throws once copies copies have been made, if copies is not negative
+struct Fragile {
+	static int copies;
+	int value;
+	Fragile(int v) : value(v) {}
+	Fragile(const Fragile &other) : value(other.value) {
+		if (copies == 0) {
+			throw sjtu::runtime_error();
+		}
+		if (copies > 0) {
+			--copies;
+		}
+	}
+	Fragile(Fragile &&other) noexcept = default;
+	Fragile &operator=(const Fragile &other) = default;
+	Fragile &operator=(Fragile &&other) noexcept = default;
+	bool operator<(const Fragile &rhs) const {
+		return value < rhs.value;
+	}
+};
+int Fragile::copies = -1;
+
+void TestThrowingCopy()
+{
+	std::cout << "Testing a throwing copy..." << std::endl;
+	sjtu::top_k<Fragile> a(20), b(20);
+	for (int i = 0; i < 100; ++i) {
+		a.push(Fragile(Rand() % 1000));
+		b.push(Fragile(Rand() % 1000));
+	}
+	int caught = 0;
+	for (int copies = 0; copies < 30; copies += 3) {
+		Fragile::copies = copies;
+		try {
+			sjtu::top_k<Fragile> c(a);
+		} catch (const sjtu::runtime_error &) {
+			++caught;
+		}
+		Fragile::copies = copies;
+		try {
+			a.merge(b);
+		} catch (const sjtu::runtime_error &) {
+			++caught;
+		}
+		Fragile::copies = -1;
+	}
+	std::cout << "caught " << caught << ", " << a.size() << " " << b.size() << " " << a.threshold().value << std::endl;
+}
+
+void TestCopyAndMove()
+{
+	std::cout << "Testing copies and moves..." << std::endl;
+	sjtu::top_k<std::string> a(5);
+	try {
+		a.threshold();
+	} catch (const sjtu::container_is_empty &) {
+		std::cout << "empty threshold" << std::endl;
+	}
+	for (int i = 0; i < 50; ++i) {
+		a.push(std::to_string(Rand()));
+	}
+	sjtu::top_k<std::string> b = a;
+	sjtu::top_k<std::string> c(std::move(a));
+	std::cout << a.size() << " " << a.capacity() << " " << b.size() << " " << c.size() << " " << c.threshold() << std::endl;
+	b.push("999999");
+	a = b;
+	c = std::move(b);
+	sjtu::vector<std::string> out;
+	a.drain_sorted(out);
+	for (size_t i = 0; i < out.size(); ++i) {
+		std::cout << out[i] << " ";
+	}
+	std::cout << std::endl << a.size() << " " << c.size() << " " << c.threshold() << std::endl;
+}
+
+void TestThrowingDrain()
+{
+	std::cout << "Testing drain_sorted with a throwing comparator..." << std::endl;
+	sjtu::top_k<int, Budget> t(300);
+	long long sum = 0;
+	for (int i = 0; i < 300; ++i) {
+		int x = Rand() % 1000;
+		t.push(x);
+		sum += x;
+	}
+	sjtu::vector<int> out(1, -1);
+	int caught = 0, unchanged = 0;
+	for (int budget = 0; budget < 5000; budget += 97) {
+		Budget::budget = budget;
+		try {
+			t.drain_sorted(out);
+			Budget::budget = -1;
+			break;
+		} catch (const sjtu::runtime_error &) {
+			++caught;
+		}
+		Budget::budget = -1;
+		long long now = 0;
+		for (int x : t) {
+			now += x;
+		}
+		unchanged += t.size() == 300 && now == sum && out.size() == 1 && out[0] == -1;
+	}
+	bool sorted = out.size() == 300;
+	for (size_t i = 1; i < out.size(); ++i) {
+		sorted = sorted && out[i] <= out[i - 1];
+	}
+	std::cout << "caught " << caught << ", unchanged " << unchanged << ", " << t.size() << " "
+		<< (sorted ? "sorted" : "not sorted") << std::endl;
+}
+
+int main()
+{
+	TestAgainstQueue();
+	TestMerge();
+	TestRollback();
+	TestThrowingCopy();
+	TestCopyAndMove();
+	TestThrowingDrain();
+	return 0;
+}
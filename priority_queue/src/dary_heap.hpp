@@ -0,0 +1,183 @@
+// implicit d-ary heap
+// Reference : https://en.wikipedia.org/wiki/D-ary_heap
+
+#ifndef SJTU_DARY_HEAP_HPP
+#define SJTU_DARY_HEAP_HPP
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include "exceptions.hpp"
+#include "../../vector/src/vector.hpp"
+
+namespace sjtu {
+/**
+ * @brief a priority queue with the push/top/pop interface of sjtu::priority_queue,
+ * kept as an implicit heap in one sjtu::vector: the children of index i are
+ * D * i + 1 ... D * i + D. There are no nodes, no pointers and no allocation per
+ * element, and with D = 4 or 8 all children of a node share one or two cache lines.
+ * There is no merge(); use sjtu::priority_queue when queues have to be melded.
+ * **Exception Safety**: every comparison of an operation is made before any element
+ * moves, so if Compare throws, the heap is left as it was. Moving T must not throw.
+ */
+template<typename T, class Compare = std::less<T>, size_t D = 4>
+class dary_heap {
+  static_assert(D >= 2, "a heap node needs at least two children");
+
+public:
+  /**
+   * @brief default constructor
+   */
+  dary_heap() = default;
+  dary_heap(const dary_heap &other) = default;
+  dary_heap(dary_heap &&other) noexcept {
+    heap_.swap(other.heap_);
+  }
+  dary_heap &operator=(const dary_heap &other) = default;
+  dary_heap &operator=(dary_heap &&other) noexcept {
+    if (this != &other) {
+      heap_.swap(other.heap_);
+      other.heap_.clear();
+    }
+    return *this;
+  }
+
+  /**
+   * @brief get the top element of the heap.
+   * @return a reference of the top element.
+   * @throws container_is_empty if empty() returns true
+   */
+  const T & top() const {
+    if (empty()) {
+      throw container_is_empty();
+    }
+    return heap_[0];
+  }
+
+  /**
+   * @brief push new element to the heap.
+   * @param e the element to be pushed
+   */
+  void push(const T &e) {
+    heap_.push_back(e);
+    size_t hole = heap_.size() - 1, target = hole;
+    T *a = heap_.data();
+    try {
+      while (target > 0 && cmp_(a[Parent(target)], a[hole])) {
+        target = Parent(target);
+      }
+    } catch (...) {
+      heap_.pop_back();
+      throw;
+    }
+    if (target == hole) {
+      return;
+    }
+    T value(std::move(a[hole]));
+    for (; hole != target; hole = Parent(hole)) {
+      a[hole] = std::move(a[Parent(hole)]);
+    }
+    a[target] = std::move(value);
+  }
+
+  /**
+   * @brief delete the top element from the heap.
+   * @throws container_is_empty if empty() returns true
+   */
+  void pop() {
+    size_t path[kMaxDepth + 1];
+    MoveAlongPath(path, FindPath(path));
+  }
+  /**
+   * @brief delete the top element from the heap and return it.
+   * @return the former top element
+   * @throws container_is_empty if empty() returns true
+   */
+  T pop_value() {
+    size_t path[kMaxDepth + 1];
+    size_t depth = FindPath(path);
+    T value(std::move(heap_[0]));
+    MoveAlongPath(path, depth);
+    return value;
+  }
+
+  /**
+   * @brief return the number of elements in the heap.
+   * @return the number of elements.
+   */
+  size_t size() const {
+    return heap_.size();
+  }
+
+  /**
+   * @brief check if the container is empty.
+   * @return true if it is empty, false otherwise.
+   */
+  bool empty() const {
+    return heap_.empty();
+  }
+
+  /**
+   * @brief make sure that the next n pushes do not reallocate.
+   */
+  void reserve(size_t n) {
+    heap_.reserve(n);
+  }
+
+private:
+  // a path from the root to a leaf visits at most this many levels
+  static constexpr size_t kMaxDepth = sizeof(size_t) * 8;
+  vector<T> heap_;
+  Compare cmp_;
+
+  static size_t Parent(size_t i) {
+    return (i - 1) / D;
+  }
+  /**
+   * finds where the last element goes once the root is removed, without moving
+   * anything: it walks from the root down to a leaf along the larger child, then
+   * back up while the last element is larger (fewer comparisons than stopping on
+   * the way down, since the last element usually belongs near the bottom).
+   * The path is left in path[0 .. depth], the last element goes to path[depth].
+   */
+  size_t FindPath(size_t *path) {
+    if (empty()) {
+      throw container_is_empty();
+    }
+    const T *a = heap_.data();
+    size_t n = heap_.size() - 1, depth = 0, cur = 0;
+    path[0] = 0;
+    for (size_t child = 1; child < n; child = D * cur + 1) {
+      size_t last = child + D < n ? child + D : n, best = child;
+      for (++child; child < last; ++child) {
+        if (cmp_(a[best], a[child])) {
+          best = child;
+        }
+      }
+      path[++depth] = cur = best;
+    }
+    while (depth > 0 && cmp_(a[path[depth]], a[n])) {
+      --depth;
+    }
+    return depth;
+  }
+  /**
+   * moves the elements on path[1 .. depth] one level up and the last element into
+   * path[depth], overwriting the root, then drops the last slot.
+   */
+  void MoveAlongPath(const size_t *path, size_t depth) {
+    T *a = heap_.data();
+    size_t n = heap_.size() - 1;
+    if (n > 0) {
+      for (size_t i = 0; i < depth; ++i) {
+        a[path[i]] = std::move(a[path[i + 1]]);
+      }
+      a[path[depth]] = std::move(a[n]);
+    }
+    heap_.pop_back();
+  }
+};
+
+}
+
+#endif
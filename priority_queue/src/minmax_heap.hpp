@@ -0,0 +1,287 @@
+// min-max heap, a double-ended priority queue
+// Reference : Atkinson, Sack, Santoro and Strothotte, "Min-max heaps and generalized priority queues"
+
+#ifndef SJTU_MINMAX_HEAP_HPP
+#define SJTU_MINMAX_HEAP_HPP
+
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include "exceptions.hpp"
+#include "../../vector/src/vector.hpp"
+
+namespace sjtu {
+/**
+ * @brief a priority queue that gives both its smallest and its largest element by
+ * Compare, kept as an implicit binary heap in one sjtu::vector. Levels alternate
+ * between min levels, starting with the root, and max levels: an element on a min
+ * level is not greater than anything below it, one on a max level not less. So the
+ * minimum is the root and the maximum one of its two children. min() and max() are
+ * O(1), push, pop_min() and pop_max() O(log n), and building from n elements O(n).
+ * **Exception Safety**: every comparison of an operation is made before any element
+ * moves, so if Compare throws, the heap is left as it was and runtime_error is thrown.
+ * Moving T must not throw.
+ */
+template<typename T, class Compare = std::less<T>>
+class minmax_heap {
+public:
+  /**
+   * @brief default constructor
+   */
+  minmax_heap() = default;
+  /**
+   * @brief build a heap of the elements in [first, last) in O(n).
+   */
+  template<typename ForwardIt, typename = decltype(*std::declval<ForwardIt &>())>
+  minmax_heap(ForwardIt first, ForwardIt last) : heap_(first, last) {
+    Heapify();
+  }
+  /**
+   * @brief build a heap of the elements of v in O(n).
+   */
+  explicit minmax_heap(const vector<T> &v) : heap_(v) {
+    Heapify();
+  }
+  minmax_heap(const minmax_heap &other) = default;
+  minmax_heap(minmax_heap &&other) noexcept {
+    heap_.swap(other.heap_);
+  }
+  minmax_heap &operator=(const minmax_heap &other) = default;
+  minmax_heap &operator=(minmax_heap &&other) noexcept {
+    if (this != &other) {
+      heap_.swap(other.heap_);
+      other.heap_.clear();
+    }
+    return *this;
+  }
+
+  /**
+   * @brief get the smallest element.
+   * @throws container_is_empty if empty() returns true
+   */
+  const T & min() const {
+    if (empty()) {
+      throw container_is_empty();
+    }
+    return heap_[0];
+  }
+  /**
+   * @brief get the largest element.
+   * @throws container_is_empty if empty() returns true
+   */
+  const T & max() const {
+    return heap_[MaxIndex()];
+  }
+
+  /**
+   * @brief push new element to the heap.
+   * @param e the element to be pushed
+   */
+  void push(const T &e) {
+    heap_.push_back(e);
+    size_t path[kMaxDepth + 1], depth;
+    try {
+      depth = FindUpPath(path);
+    } catch (...) {
+      heap_.pop_back();
+      throw runtime_error();
+    }
+    T *a = heap_.data();
+    T value(std::move(a[path[0]]));
+    for (size_t i = 0; i < depth; ++i) {
+      a[path[i]] = std::move(a[path[i + 1]]);
+    }
+    a[path[depth]] = std::move(value);
+  }
+
+  /**
+   * @brief delete the smallest element.
+   * @throws container_is_empty if empty() returns true
+   */
+  void pop_min() {
+    if (empty()) {
+      throw container_is_empty();
+    }
+    Erase(0);
+  }
+  /**
+   * @brief delete the largest element.
+   * @throws container_is_empty if empty() returns true
+   */
+  void pop_max() {
+    Erase(MaxIndex());
+  }
+
+  /**
+   * @brief return the number of elements in the heap.
+   * @return the number of elements.
+   */
+  size_t size() const {
+    return heap_.size();
+  }
+
+  /**
+   * @brief check if the container is empty.
+   * @return true if it is empty, false otherwise.
+   */
+  bool empty() const {
+    return heap_.empty();
+  }
+
+  /**
+   * @brief make sure that the next n pushes do not reallocate.
+   */
+  void reserve(size_t n) {
+    heap_.reserve(n);
+  }
+
+private:
+  // a path along the levels of the heap visits at most this many of them
+  static constexpr size_t kMaxDepth = sizeof(size_t) * 8;
+  vector<T> heap_;
+  mutable Compare cmp_; // max() is const, but Compare's call need not be
+
+  static bool IsMaxLevel(size_t i) {
+    // index i is on level bit_width(i + 1) - 1
+    return (std::bit_width(i + 1) & 1) == 0;
+  }
+  /**
+   * whether a belongs nearer the top than b on a max level (a is greater) or a min
+   * level (a is less).
+   */
+  bool Before(bool max_level, const T &a, const T &b) {
+    return max_level ? cmp_(b, a) : cmp_(a, b);
+  }
+  size_t MaxIndex() const {
+    if (empty()) {
+      throw container_is_empty();
+    }
+    if (size() < 3) {
+      return size() - 1;
+    }
+    try {
+      return cmp_(heap_[1], heap_[2]) ? 2 : 1;
+    } catch (...) {
+      throw runtime_error();
+    }
+  }
+  /**
+   * finds where the last element goes: across to its parent's kind of level if it
+   * belongs there, then up the levels of that kind, two at a time. The path is
+   * left in path[0 .. depth], starting at the last slot.
+   */
+  size_t FindUpPath(size_t *path) {
+    const T *a = heap_.data();
+    size_t cur = heap_.size() - 1, depth = 0;
+    const T &x = a[cur];
+    path[0] = cur;
+    if (cur == 0) {
+      return 0;
+    }
+    bool max_level = IsMaxLevel(cur);
+    if (Before(!max_level, x, a[(cur - 1) / 2])) {
+      max_level = !max_level;
+      path[++depth] = cur = (cur - 1) / 2;
+    }
+    // cur has a grandparent from index 3 on
+    while (cur >= 3 && Before(max_level, x, a[(cur - 3) / 4])) {
+      path[++depth] = cur = (cur - 3) / 4;
+    }
+    return depth;
+  }
+  /**
+   * finds where the element at carried goes when the hole at path[0] is filled
+   * from below, using only the first n slots. Each step moves the best of the
+   * children and grandchildren of the hole up into it; when that is a grandchild, the
+   * carried element and the grandchild's parent are exchanged if they are out of order,
+   * which bit i of swaps records for step i. Nothing moves; see Apply.
+   */
+  size_t FindDownPath(size_t *path, unsigned long long &swaps, size_t carried, size_t n) {
+    const T *a = heap_.data();
+    const bool max_level = IsMaxLevel(path[0]);
+    size_t depth = 0, cur = path[0];
+    swaps = 0;
+    while (2 * cur + 1 < n) {
+      size_t best = 2 * cur + 1, last = 4 * cur + 7 < n ? 4 * cur + 7 : n;
+      if (best + 1 < n && Before(max_level, a[best + 1], a[best])) {
+        ++best;
+      }
+      for (size_t i = 4 * cur + 3; i < last; ++i) {
+        if (Before(max_level, a[i], a[best])) {
+          best = i;
+        }
+      }
+      if (!Before(max_level, a[best], a[carried])) {
+        break;
+      }
+      path[++depth] = cur = best;
+      if (best <= 2 * path[depth - 1] + 2) {
+        break;
+      }
+      size_t parent = (best - 1) / 2;
+      if (Before(max_level, a[parent], a[carried])) {
+        swaps |= 1ull << depth;
+        carried = parent;
+      }
+    }
+    return depth;
+  }
+  /**
+   * carries out what FindDownPath found, taking the carried element from slot from.
+   */
+  void Apply(const size_t *path, size_t depth, unsigned long long swaps, size_t from) {
+    T *a = heap_.data();
+    T carried(std::move(a[from]));
+    for (size_t i = 1; i <= depth; ++i) {
+      a[path[i - 1]] = std::move(a[path[i]]);
+      if (swaps >> i & 1) {
+        std::swap(carried, a[(path[i] - 1) / 2]);
+      }
+    }
+    a[path[depth]] = std::move(carried);
+  }
+  /**
+   * removes the element at index i, the minimum or the maximum, by filling its slot
+   * with the last element.
+   */
+  void Erase(size_t i) {
+    size_t n = heap_.size() - 1;
+    if (i != n) {
+      size_t path[kMaxDepth + 1];
+      unsigned long long swaps;
+      path[0] = i;
+      size_t depth;
+      try {
+        depth = FindDownPath(path, swaps, n, n);
+      } catch (...) {
+        throw runtime_error();
+      }
+      Apply(path, depth, swaps, n);
+    }
+    heap_.pop_back();
+  }
+  /**
+   * Floyd's bottom-up construction, filling each hole from below in turn.
+   */
+  void Heapify() {
+    size_t n = heap_.size(), path[kMaxDepth + 1];
+    unsigned long long swaps;
+    for (size_t i = n / 2; i-- > 0;) {
+      path[0] = i;
+      size_t depth;
+      try {
+        depth = FindDownPath(path, swaps, i, n);
+      } catch (...) {
+        throw runtime_error();
+      }
+      if (depth > 0) {
+        Apply(path, depth, swaps, i);
+      }
+    }
+  }
+};
+
+}
+
+#endif
@@ -0,0 +1,171 @@
+// relaxed concurrent priority queue
+// Reference : Rihani, Sanders and Dementiev, "MultiQueues: Simple Relaxed Concurrent Priority Queues"
+
+#ifndef SJTU_MULTI_QUEUE_HPP
+#define SJTU_MULTI_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include "exceptions.hpp"
+#include "dary_heap.hpp"
+
+namespace sjtu {
+/**
+ * @brief a priority queue for many threads that gives up exact order for throughput.
+ * It is made of factor * threads array heaps, each behind its own try-lock: push goes
+ * to a random heap, and try_pop takes the better of the tops of two random heaps.
+ * A thread never waits for a lock; if one is taken, it picks other heaps.
+ * The popped element is not always the best one, but close to it: its expected rank
+ * grows with the number of heaps, so factor tunes the relaxation; 2 is a good start.
+ * size() and empty() are only snapshots while other threads are working.
+ * **Exception Safety**: if Compare throws, the queue is left as it was and the
+ * exception is passed on, as in sjtu::dary_heap.
+ */
+template<typename T, class Compare = std::less<T>>
+class multi_queue {
+public:
+  /**
+   * @param threads the number of threads that will use the queue
+   * @param factor the number of heaps per thread
+   */
+  explicit multi_queue(size_t threads, size_t factor = 2) {
+    count_ = threads * factor < 2 ? 2 : threads * factor;
+    heaps_ = new slot[count_];
+  }
+  multi_queue(const multi_queue &) = delete;
+  multi_queue &operator=(const multi_queue &) = delete;
+  ~multi_queue() {
+    delete [] heaps_;
+  }
+
+  /**
+   * @brief push new element to a random heap.
+   * @param e the element to be pushed
+   */
+  void push(const T &e) {
+    while (true) {
+      slot &s = heaps_[Random() % count_];
+      if (!TryLock(s)) {
+        continue;
+      }
+      try {
+        s.heap_.push(e);
+      } catch (...) {
+        Unlock(s);
+        throw;
+      }
+      // count it before the element can be seen, so that a pop's decrement never comes first
+      size_.fetch_add(1, std::memory_order_relaxed);
+      Unlock(s);
+      return;
+    }
+  }
+
+  /**
+   * @brief take the better of the tops of two random heaps.
+   * @param out receives the element
+   * @return false if the queue was found empty, out is untouched then
+   */
+  bool try_pop(T &out) {
+    while (true) {
+      size_t i = Random() % count_, j = Random() % (count_ - 1);
+      j += j >= i;
+      slot &a = heaps_[i], &b = heaps_[j];
+      if (!TryLock(a)) {
+        continue;
+      }
+      if (!TryLock(b)) {
+        Unlock(a);
+        continue;
+      }
+      slot *best;
+      try {
+        best = Better(a, b);
+        if (best != nullptr) {
+          out = best->heap_.pop_value();
+        }
+      } catch (...) {
+        Unlock(b);
+        Unlock(a);
+        throw;
+      }
+      Unlock(b);
+      Unlock(a);
+      if (best != nullptr) {
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+      }
+      if (empty()) {
+        return false;
+      }
+    }
+  }
+
+  /**
+   * @brief return the number of elements in the queue.
+   */
+  size_t size() const {
+    return size_.load(std::memory_order_relaxed);
+  }
+  /**
+   * @brief check if the container is empty.
+   */
+  bool empty() const {
+    return size() == 0;
+  }
+  /**
+   * @brief the number of heaps, factor * threads.
+   */
+  size_t heaps() const {
+    return count_;
+  }
+
+private:
+  // one per cache line, so that threads working on different heaps do not share lines
+  struct alignas(64) slot {
+    std::atomic<bool> locked_{false};
+    dary_heap<T, Compare, 4> heap_;
+  };
+  slot *heaps_;
+  size_t count_;
+  std::atomic<size_t> size_{0};
+  Compare cmp_;
+
+  static bool TryLock(slot &s) {
+    // read first, so that a taken lock costs no write to its cache line
+    return !s.locked_.load(std::memory_order_relaxed) && !s.locked_.exchange(true, std::memory_order_acquire);
+  }
+  static void Unlock(slot &s) {
+    s.locked_.store(false, std::memory_order_release);
+  }
+  /**
+   * the heap with the better top, or nullptr if both are empty.
+   */
+  slot *Better(slot &a, slot &b) {
+    if (a.heap_.empty()) {
+      return b.heap_.empty() ? nullptr : &b;
+    }
+    if (b.heap_.empty()) {
+      return &a;
+    }
+    return cmp_(a.heap_.top(), b.heap_.top()) ? &b : &a;
+  }
+  /**
+   * xorshift, one generator per thread, seeded from the order in which threads first get here.
+   */
+  static size_t Random() {
+    static std::atomic<unsigned long long> seeds{0};
+    static thread_local unsigned long long state =
+        (seeds.fetch_add(1, std::memory_order_relaxed) + 1) * 0x9E3779B97F4A7C15ull;
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return static_cast<size_t>(state >> 11);
+  }
+};
+
+}
+
+#endif
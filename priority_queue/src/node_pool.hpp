@@ -0,0 +1,199 @@
+// slab allocator for the nodes of node-based heaps
+
+#ifndef SJTU_NODE_POOL_HPP
+#define SJTU_NODE_POOL_HPP
+
+#include <cstddef>
+#include <new>
+
+namespace sjtu {
+/**
+ * hands out uninitialized blocks that fit one Node, carved from slabs of many
+ * blocks each. Free blocks are kept on an intrusive list of runs of consecutive
+ * blocks, so a whole slab, or the free blocks of a joined pool, is added in O(1).
+ * Slabs go back to the system only when the pool dies or is reset, all at once.
+ *
+ * A pool is reference counted, so several heaps can take their nodes from the
+ * same pool. join() moves every slab of another pool into this one; if that pool
+ * still has holders, it forwards them here from then on, so root() is the pool
+ * that really owns the memory.
+ * Not thread-safe.
+ */
+template<typename Node>
+class node_pool {
+public:
+  node_pool(const node_pool &) = delete;
+  node_pool &operator = (const node_pool &) = delete;
+
+  /**
+   * a new empty pool with one holder.
+   */
+  static node_pool *create() {
+    return new node_pool();
+  }
+  /**
+   * adds a holder to the pool that owns the memory of p and returns that pool.
+   */
+  static node_pool *acquire(node_pool *p) {
+    p = p->root();
+    ++p->refs_;
+    return p;
+  }
+  /**
+   * drops one holder of p; the last one frees all slabs.
+   */
+  static void release(node_pool *p) {
+    while (p != nullptr && --p->refs_ == 0) {
+      node_pool *parent = p->parent_;
+      delete p;
+      p = parent;
+    }
+  }
+
+  node_pool *root() {
+    node_pool *p = this;
+    while (p->parent_ != nullptr) {
+      p = p->parent_;
+    }
+    return p;
+  }
+  /**
+   * whether the caller, holding this pool, is the only one using its memory.
+   */
+  bool exclusive() const {
+    return parent_ == nullptr && refs_ == 1;
+  }
+
+  void *allocate() {
+    if (free_ == nullptr) {
+      AddSlab(capacity_ < kMinSlab ? kMinSlab : capacity_);
+    }
+    run *r = free_;
+    if (r->count_ == 1) {
+      free_ = r->nxt_;
+      if (free_ == nullptr) {
+        free_tail_ = nullptr;
+      }
+    } else { // hand out the first block of the run, the rest stays on the list
+      run *rest = reinterpret_cast<run *>(reinterpret_cast<Node *>(r) + 1);
+      rest->nxt_ = r->nxt_;
+      rest->count_ = r->count_ - 1;
+      free_ = rest;
+      if (free_tail_ == r) {
+        free_tail_ = rest;
+      }
+    }
+    --free_count_;
+    return r;
+  }
+  void deallocate(void *p) {
+    PushRun(static_cast<Node *>(p), 1);
+  }
+  /**
+   * makes sure that the next n allocations need no new slab.
+   */
+  void reserve(size_t n) {
+    if (n > free_count_) {
+      AddSlab(n - free_count_);
+    }
+  }
+  /**
+   * frees every slab at once, all blocks handed out become invalid.
+   */
+  void reset() {
+    FreeSlabs();
+    free_ = free_tail_ = nullptr;
+    free_count_ = capacity_ = 0;
+  }
+  /**
+   * takes over the slabs and free blocks of other, another root pool, in O(number of slabs).
+   */
+  void join(node_pool *other) {
+    if (other == this) {
+      return;
+    }
+    if (other->slabs_ != nullptr) {
+      slab *last = other->slabs_;
+      while (last->nxt_ != nullptr) {
+        last = last->nxt_;
+      }
+      last->nxt_ = slabs_;
+      slabs_ = other->slabs_;
+    }
+    if (other->free_ != nullptr) {
+      other->free_tail_->nxt_ = free_;
+      free_ = other->free_;
+      if (free_tail_ == nullptr) {
+        free_tail_ = other->free_tail_;
+      }
+    }
+    free_count_ += other->free_count_;
+    capacity_ += other->capacity_;
+    other->slabs_ = nullptr;
+    other->free_ = other->free_tail_ = nullptr;
+    other->free_count_ = other->capacity_ = 0;
+    if (other->refs_ > 1 || other->parent_ != nullptr) { // someone else still holds other
+      other->parent_ = this;
+      ++refs_;
+    }
+  }
+
+private:
+  static constexpr size_t kMinSlab = 64;
+  // count_ consecutive free blocks; a fresh slab is a single run
+  struct run {
+    run *nxt_;
+    size_t count_;
+  };
+  struct slab {
+    slab *nxt_;
+  };
+  static_assert(sizeof(Node) >= sizeof(run), "a free run must fit in a node");
+  // blocks start after the slab header, rounded up to the alignment of Node
+  static constexpr size_t kHeader = (sizeof(slab) + alignof(Node) - 1) / alignof(Node) * alignof(Node);
+  static constexpr size_t kAlign = alignof(Node) > alignof(slab) ? alignof(Node) : alignof(slab);
+
+  slab *slabs_ = nullptr;
+  run *free_ = nullptr, *free_tail_ = nullptr;
+  size_t free_count_ = 0, capacity_ = 0;
+  size_t refs_ = 1;
+  node_pool *parent_ = nullptr;
+
+  node_pool() = default;
+  ~node_pool() {
+    FreeSlabs();
+  }
+
+  /**
+   * a slab of count blocks, put on the free list as one run.
+   */
+  void AddSlab(size_t count) {
+    void *memory = operator new(kHeader + count * sizeof(Node), std::align_val_t(kAlign));
+    slab *s = static_cast<slab *>(memory);
+    s->nxt_ = slabs_;
+    slabs_ = s;
+    PushRun(reinterpret_cast<Node *>(static_cast<char *>(memory) + kHeader), count);
+    capacity_ += count;
+  }
+  void PushRun(Node *first, size_t count) {
+    run *r = reinterpret_cast<run *>(first);
+    r->nxt_ = free_;
+    r->count_ = count;
+    free_ = r;
+    if (free_tail_ == nullptr) {
+      free_tail_ = r;
+    }
+    free_count_ += count;
+  }
+  void FreeSlabs() {
+    while (slabs_ != nullptr) {
+      slab *nxt = slabs_->nxt_;
+      operator delete(slabs_, std::align_val_t(kAlign));
+      slabs_ = nxt;
+    }
+  }
+};
+
+}
+
+#endif
@@ -0,0 +1,581 @@
+// addressable pairing heap
+// Reference : Fredman, Sedgewick, Sleator and Tarjan, "The pairing heap: a new form of self-adjusting heap"
+
+#ifndef SJTU_PAIRING_HEAP_HPP
+#define SJTU_PAIRING_HEAP_HPP
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "exceptions.hpp"
+#include "node_pool.hpp"
+#include "../../vector/src/vector.hpp"
+
+namespace sjtu {
+/**
+ * @brief a priority queue like sjtu::priority_queue whose push returns a handle to
+ * the element, so that its key can later be changed or the element erased, as
+ * Dijkstra, Prim or A* need without pushing duplicates.
+ * push, top, merge and increase_key are O(1); pop, decrease_key and erase are
+ * O(log n) amortized.
+ * A handle stays valid until its element is popped or erased, also when the
+ * element moves into another heap by merge; it is then used with that heap.
+ * As in std::priority_queue, top() is the largest element by Compare, so
+ * increase_key moves an element towards the top; a min-heap over distances
+ * (Compare = std::greater) therefore calls increase_key when a distance drops.
+ * **Exception Safety**: if Compare throws, the heap is left as it was; every
+ * comparison of an operation is made before the heap is changed. Moving T must not throw.
+ */
+template<typename T, class Compare = std::less<T>>
+class pairing_heap {
+  struct node;
+
+public:
+  /**
+   * @brief refers to one element of a heap. A default-constructed handle refers to nothing.
+   */
+  class handle {
+  public:
+    handle() = default;
+    bool operator==(const handle &rhs) const {
+      return node_ == rhs.node_;
+    }
+    bool operator!=(const handle &rhs) const {
+      return node_ != rhs.node_;
+    }
+
+  private:
+    friend class pairing_heap;
+    node *node_ = nullptr;
+    explicit handle(node *x) : node_(x) {}
+  };
+
+  /**
+   * @brief default constructor
+   */
+  pairing_heap() = default;
+
+  /**
+   * @brief copy constructor. Handles keep referring to the elements of other.
+   * @param other the pairing_heap to be copied
+   */
+  pairing_heap(const pairing_heap &other) {
+    if (!other.empty()) {
+      CopyFrom(other);
+    }
+  }
+
+  /**
+   * @brief move constructor, O(1). Handles move along with the elements.
+   * @param other the pairing_heap to be moved from, empty afterwards
+   */
+  pairing_heap(pairing_heap &&other) noexcept {
+    Steal(other);
+  }
+
+  /**
+   * @brief deconstructor
+   */
+  ~pairing_heap() {
+    Clear();
+    pool_type::release(pool_);
+  }
+
+  /**
+   * @brief Assignment operator
+   * @param other the pairing_heap to be assigned from
+   * @return a reference to this pairing_heap after assignment
+   */
+  pairing_heap &operator=(const pairing_heap &other) {
+    if (this == &other) {
+      return *this;
+    }
+    Clear();
+    if (!other.empty()) {
+      CopyFrom(other);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief move assignment operator
+   * @param other the pairing_heap to be moved from, empty afterwards
+   * @return a reference to this pairing_heap after assignment
+   */
+  pairing_heap &operator=(pairing_heap &&other) noexcept {
+    if (this == &other) {
+      return *this;
+    }
+    Clear();
+    pool_type::release(pool_);
+    pool_ = nullptr;
+    Steal(other);
+    return *this;
+  }
+
+  /**
+   * @brief get the top element of the heap.
+   * @return a reference of the top element.
+   * @throws container_is_empty if empty() returns true
+   */
+  const T & top() const {
+    if (empty()) {
+      throw container_is_empty();
+    }
+    return root_->val_;
+  }
+  /**
+   * @brief a handle to the top element.
+   * @throws container_is_empty if empty() returns true
+   */
+  handle top_handle() const {
+    if (empty()) {
+      throw container_is_empty();
+    }
+    return handle(root_);
+  }
+  /**
+   * @brief the element h refers to.
+   */
+  const T &value(handle h) const {
+    return h.node_->val_;
+  }
+
+  /**
+   * @brief push new element to the heap.
+   * @param e the element to be pushed
+   * @return a handle to the new element
+   */
+  handle push(const T &e) {
+    return Insert(NewNode(e));
+  }
+  handle push(T &&e) {
+    return Insert(NewNode(std::move(e)));
+  }
+  /**
+   * @brief construct a new element in place from args and push it.
+   * @return a handle to the new element
+   */
+  template<typename... Args>
+  handle emplace(Args &&...args) {
+    return Insert(NewNode(std::forward<Args>(args)...));
+  }
+
+  /**
+   * @brief delete the top element from the heap.
+   * @throws container_is_empty if empty() returns true
+   */
+  void pop() {
+    DeleteNode(Unlink());
+  }
+  /**
+   * @brief delete the top element from the heap and return it.
+   * @return the former top element
+   * @throws container_is_empty if empty() returns true
+   */
+  T pop_value() {
+    node *top = Unlink();
+    try {
+      T value(std::move(top->val_));
+      DeleteNode(top);
+      return value;
+    } catch (...) {
+      DeleteNode(top);
+      throw;
+    }
+  }
+
+  /**
+   * @brief give the element of h the larger key e, moving it towards the top. O(1).
+   * e must not be less than the current key.
+   */
+  void increase_key(handle h, const T &e) {
+    IncreaseKey(h.node_, T(e));
+  }
+  /**
+   * @brief give the element of h the smaller key e, moving it away from the top.
+   * O(log n) amortized. e must not be greater than the current key.
+   */
+  void decrease_key(handle h, const T &e) {
+    DecreaseKey(h.node_, T(e));
+  }
+  /**
+   * @brief give the element of h the key e, whichever way it moves.
+   */
+  void update(handle h, const T &e) {
+    T key(e);
+    if (cmp_(h.node_->val_, key)) {
+      IncreaseKey(h.node_, std::move(key));
+    } else {
+      DecreaseKey(h.node_, std::move(key));
+    }
+  }
+  /**
+   * @brief delete the element of h from the heap; h becomes invalid. O(log n) amortized.
+   */
+  void erase(handle h) {
+    node *x = h.node_;
+    if (x == root_) {
+      pop();
+      return;
+    }
+    if (x->child_ != nullptr) {
+      PlanCombine(x->child_);
+    }
+    Cut(x);
+    if (x->child_ != nullptr) {
+      Link(root_, Combine(x->child_));
+    }
+    DeleteNode(x);
+    --size_;
+  }
+
+  /**
+   * @brief return the number of elements in the heap.
+   * @return the number of elements.
+   */
+  size_t size() const {
+    return size_;
+  }
+
+  /**
+   * @brief check if the container is empty.
+   * @return true if it is empty, false otherwise.
+   */
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  /**
+   * @brief merge another pairing_heap into this one in O(1) (plus handing over its
+   * slabs). The other heap is empty afterwards; handles to its elements now refer to
+   * elements of this heap.
+   * @param other the pairing_heap to be merged.
+   */
+  void merge(pairing_heap &other) {
+    if (other.empty() || this == &other) {
+      return;
+    }
+    if (empty()) {
+      pool_type::release(pool_);
+      pool_ = nullptr;
+      Steal(other);
+      return;
+    }
+    bool other_wins = cmp_(root_->val_, other.root_->val_);
+    AdoptNodes(other);
+    root_ = other_wins ? Link(other.root_, root_) : Link(root_, other.root_);
+    size_ += other.size_;
+    other.root_ = nullptr;
+    other.size_ = 0;
+  }
+
+  /**
+   * @brief make room for n more elements, so that the next n pushes allocate no memory.
+   */
+  void reserve(size_t n) {
+    Pool()->reserve(n);
+  }
+
+private:
+  // the children of a node form a list through next_; prev_ is the left sibling,
+  // or the parent for the first child, and nullptr for the root
+  struct node {
+    T val_;
+    node *child_ = nullptr, *next_ = nullptr, *prev_ = nullptr;
+    unsigned char plan_ = 0; // the outcome of the comparisons planned by PlanCombine
+    node() = delete;
+    template<typename... Args>
+    explicit node(std::in_place_t, Args &&...args) : val_(std::forward<Args>(args)...) {}
+  };
+  using pool_type = node_pool<node>;
+  // plan_ bits: on the first node of a pair, whether the second one wins;
+  // on the winner of a pair, whether it goes below the combination of the pairs right of it
+  static constexpr unsigned char kSecondWins = 1, kRightWins = 2;
+  node *root_ = nullptr;
+  size_t size_ = 0;
+  Compare cmp_;
+  pool_type *pool_ = nullptr; // created on first use
+
+  pool_type *Pool() {
+    if (pool_ == nullptr) {
+      pool_ = pool_type::create();
+    }
+    return pool_->root();
+  }
+  template<typename... Args>
+  node *NewNode(Args &&...args) {
+    pool_type *pool = Pool();
+    void *p = pool->allocate();
+    try {
+      return new(p) node(std::in_place, std::forward<Args>(args)...);
+    } catch (...) {
+      pool->deallocate(p);
+      throw;
+    }
+  }
+  void DeleteNode(node *x) {
+    x->~node();
+    pool_->root()->deallocate(x);
+  }
+  /**
+   * destroys all elements; see priority_queue::Clear.
+   */
+  void Clear() {
+    if (root_ != nullptr) {
+      if (!pool_->exclusive()) {
+        DestroyTree<true>(root_);
+      } else {
+        if (!std::is_trivially_destructible<T>::value) {
+          DestroyTree<false>(root_);
+        }
+        pool_->reset();
+      }
+    }
+    root_ = nullptr;
+    size_ = 0;
+  }
+  void Steal(pairing_heap &other) {
+    root_ = other.root_;
+    size_ = other.size_;
+    pool_ = other.pool_;
+    other.root_ = nullptr;
+    other.size_ = 0;
+    other.pool_ = nullptr;
+  }
+  /**
+   * the nodes of other are about to become ours, so are the slabs holding them.
+   */
+  void AdoptNodes(pairing_heap &other) {
+    pool_type *root = Pool(), *other_root = other.pool_->root();
+    if (root != other_root) {
+      root->join(other_root);
+    }
+  }
+  /**
+   * destroys the tree at cur without recursion, reading child_ and next_ as the
+   * left and right links of a binary tree and rotating left children up.
+   */
+  template<bool Free>
+  void DestroyTree(node *cur) {
+    while (cur != nullptr) {
+      if (cur->child_ != nullptr) {
+        node *child = cur->child_;
+        cur->child_ = child->next_;
+        child->next_ = cur;
+        cur = child;
+      } else {
+        node *nxt = cur->next_;
+        if (Free) {
+          DeleteNode(cur);
+        } else {
+          cur->~node();
+        }
+        cur = nxt;
+      }
+    }
+  }
+  /**
+   * copies the tree of other into this empty heap, keeping its shape.
+   * The stack holds the source siblings still to be copied with the copies they follow.
+   * If copying an element throws, this heap is left empty.
+   */
+  void CopyFrom(const pairing_heap &other) {
+    struct frame {
+      const node *src_;
+      node *prev_;
+      bool as_child_; // whether the copy of src_ becomes the first child of prev_, or its next sibling
+    };
+    vector<frame> stack;
+    Pool()->reserve(other.size_);
+    try {
+      root_ = NewNode(other.root_->val_);
+      stack.push_back({other.root_->child_, root_, true});
+      while (!stack.empty()) {
+        frame top = stack.back();
+        stack.pop_back();
+        if (top.src_ == nullptr) {
+          continue;
+        }
+        node *copy = NewNode(top.src_->val_);
+        copy->prev_ = top.prev_;
+        if (top.as_child_) {
+          top.prev_->child_ = copy;
+        } else {
+          top.prev_->next_ = copy;
+        }
+        stack.push_back({top.src_->next_, copy, false});
+        stack.push_back({top.src_->child_, copy, true});
+      }
+    } catch (...) {
+      Clear();
+      throw;
+    }
+    size_ = other.size_;
+  }
+
+  /**
+   * makes parent's first child out of child, another root; returns parent.
+   */
+  static node *Link(node *parent, node *child) {
+    child->prev_ = parent;
+    child->next_ = parent->child_;
+    if (parent->child_ != nullptr) {
+      parent->child_->prev_ = child;
+    }
+    parent->child_ = child;
+    return parent;
+  }
+  /**
+   * takes x, which is not the root, with its subtree out of the tree.
+   */
+  static void Cut(node *x) {
+    if (x->prev_->child_ == x) {
+      x->prev_->child_ = x->next_;
+    } else {
+      x->prev_->next_ = x->next_;
+    }
+    if (x->next_ != nullptr) {
+      x->next_->prev_ = x->prev_;
+    }
+    x->next_ = x->prev_ = nullptr;
+  }
+  static node *PairWinner(node *first) {
+    return (first->plan_ & kSecondWins) ? first->next_ : first;
+  }
+  /**
+   * makes every comparison Combine will make on the sibling list starting at first
+   * and records the outcomes in plan_, without changing any link, so an exception
+   * from Compare leaves the heap intact. Returns the node that will be the root.
+   * The two passes of the pairing heap: siblings are paired from left to right,
+   * then the pair winners are combined from right to left.
+   */
+  node *PlanCombine(node *first) {
+    node *last = first;
+    for (node *a = first; a != nullptr; a = a->next_->next_) {
+      last = a;
+      if (a->next_ == nullptr) {
+        a->plan_ = 0;
+        break;
+      }
+      a->plan_ = cmp_(a->val_, a->next_->val_) ? kSecondWins : 0;
+      a->next_->plan_ = 0;
+    }
+    node *acc = PairWinner(last);
+    for (node *a = last; a != first;) {
+      a = a->prev_->prev_; // the first node of the pair on the left
+      node *w = PairWinner(a);
+      if (cmp_(w->val_, acc->val_)) {
+        w->plan_ |= kRightWins;
+      } else {
+        acc = w;
+      }
+    }
+    return acc;
+  }
+  /**
+   * links the sibling list starting at first into one tree as PlanCombine planned
+   * it and returns its root. No comparisons.
+   */
+  static node *Combine(node *first) {
+    node *winners = nullptr; // pair winners, the rightmost first, chained through next_
+    for (node *a = first; a != nullptr;) {
+      node *b = a->next_;
+      if (b == nullptr) {
+        a->next_ = winners;
+        winners = a;
+        break;
+      }
+      node *nxt = b->next_;
+      node *w = (a->plan_ & kSecondWins) ? Link(b, a) : Link(a, b);
+      w->next_ = winners;
+      winners = w;
+      a = nxt;
+    }
+    node *acc = winners;
+    for (node *w = winners->next_; w != nullptr;) {
+      node *nxt = w->next_;
+      acc = (w->plan_ & kRightWins) ? Link(acc, w) : Link(w, acc);
+      w = nxt;
+    }
+    acc->next_ = acc->prev_ = nullptr;
+    return acc;
+  }
+
+  /**
+   * links the new node x into the heap and takes ownership of it.
+   * If Compare throws, x is freed and the exception is passed on.
+   */
+  handle Insert(node *x) {
+    if (empty()) {
+      root_ = x;
+      size_ = 1;
+      return handle(x);
+    }
+    bool x_wins;
+    try {
+      x_wins = cmp_(root_->val_, x->val_);
+    } catch (...) {
+      DeleteNode(x);
+      throw;
+    }
+    root_ = x_wins ? Link(x, root_) : Link(root_, x);
+    ++size_;
+    return handle(x);
+  }
+  /**
+   * takes the root out of the heap and returns it, its value untouched.
+   */
+  node *Unlink() {
+    if (empty()) {
+      throw container_is_empty();
+    }
+    node *top = root_;
+    if (top->child_ == nullptr) {
+      root_ = nullptr;
+    } else {
+      PlanCombine(top->child_);
+      root_ = Combine(top->child_);
+    }
+    --size_;
+    return top;
+  }
+  void IncreaseKey(node *x, T &&key) {
+    if (x == root_) {
+      x->val_ = std::move(key);
+      return;
+    }
+    bool x_wins = cmp_(root_->val_, key);
+    x->val_ = std::move(key);
+    Cut(x);
+    root_ = x_wins ? Link(x, root_) : Link(root_, x);
+  }
+  /**
+   * the children of x are combined into one tree, and x alone goes back in; the
+   * root stays above both unless x is the root itself.
+   */
+  void DecreaseKey(node *x, T &&key) {
+    if (x->child_ == nullptr) {
+      x->val_ = std::move(key);
+      return;
+    }
+    node *w = PlanCombine(x->child_);
+    bool x_wins = x == root_ && !cmp_(key, w->val_);
+    x->val_ = std::move(key);
+    node *sub = Combine(x->child_);
+    x->child_ = nullptr;
+    if (x != root_) {
+      Cut(x);
+      Link(root_, sub);
+      Link(root_, x);
+    } else {
+      root_ = x_wins ? Link(x, sub) : Link(sub, x);
+    }
+  }
+};
+
+}
+
+#endif
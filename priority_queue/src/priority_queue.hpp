@@ -6,69 +6,152 @@
 
 #include <cstddef>
 #include <functional>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include "utility.hpp"
 #include "exceptions.hpp"
+#include "node_pool.hpp"
 #include "../../vector/src/vector.hpp"
+#include "../../vector/src/sort.hpp"
 
 namespace sjtu {
 /**
  * @brief a container like std::priority_queue which is a heap internal.
  * **Exception Safety**: The `Compare` operation might throw exceptions for certain data.
  * In such cases, any ongoing operation should be terminated, and the priority queue should be restored to its original state before the operation began.
+ * Then a runtime_error is thrown, whatever Compare threw.
+ * **Lazy mode**: with Lazy = true, push and merge only put the new trees in front of
+ * or behind the root list and update the top, one comparison each, O(1). The trees
+ * of equal rank are linked on the next pop, which is O(number of roots) once and
+ * leaves a consolidated forest behind. Suits bursts of pushes and merges with few pops.
  */
-template<typename T, class Compare = std::less<T>>
+template<typename T, class Compare = std::less<T>, bool Lazy = false>
 class priority_queue {
+  struct node;
+  static constexpr size_t kMaxRank = sizeof(size_t) * 8;
+
 public:
+  /**
+   * @brief a read-only iterator over all elements in no particular order, walking
+   * the forest in preorder. The way back up is kept in the iterator, one entry per
+   * level of a binomial tree, so it needs no parent links and no allocation.
+   * Any change to the queue invalidates it.
+   */
+  class const_iterator {
+  public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using pointer = const T*;
+    using reference = const T&;
+    using iterator_category = std::forward_iterator_tag;
+
+    const_iterator() = default;
+    /**
+     * @throws invalid_iterator if the iterator is end()
+     */
+    const T &operator*() const {
+      if (cur_ == nullptr) {
+        throw invalid_iterator();
+      }
+      return cur_->val_;
+    }
+    const T *operator->() const {
+      return &**this;
+    }
+    /**
+     * @throws invalid_iterator if the iterator is end()
+     */
+    const_iterator &operator++() {
+      if (cur_ == nullptr) {
+        throw invalid_iterator();
+      }
+      if (cur_->son_ != nullptr) {
+        if (cur_->nxt_ != nullptr) {
+          stack_[depth_++] = cur_->nxt_;
+        }
+        cur_ = cur_->son_;
+      } else if (cur_->nxt_ != nullptr) {
+        cur_ = cur_->nxt_;
+      } else {
+        cur_ = depth_ == 0 ? nullptr : stack_[--depth_];
+      }
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+    bool operator==(const const_iterator &rhs) const {
+      return cur_ == rhs.cur_;
+    }
+    bool operator!=(const const_iterator &rhs) const {
+      return cur_ != rhs.cur_;
+    }
+
+  private:
+    friend class priority_queue;
+    node *cur_ = nullptr;
+    node *stack_[kMaxRank + 1] = {}; // the next sibling to visit on each level above cur_
+    size_t depth_ = 0;
+
+    explicit const_iterator(node *first) : cur_(first) {}
+  };
+
   /**
    * @brief default constructor
    */
   priority_queue() {
     size_ = 0;
-    head_ = static_cast<node *>(operator new(sizeof(node)));
-    head_->nxt_ = nullptr;
-    max_ = nullptr;
+    pool_ = nullptr;
+    head_.nxt_ = nullptr;
+    max_ = tail_ = nullptr;
     cmp_ = Compare();
   }
 
-  priority_queue(const T &e) {
+  priority_queue(const T &e) : priority_queue() {
+    head_.nxt_ = max_ = tail_ = NewNode(e);
     size_ = 1;
-    head_ = static_cast<node *>(operator new(sizeof(node)));
-    head_->nxt_ = new node(e);
-    max_ = head_->nxt_;
-    cmp_ = Compare();
   }
 
+  /**
+   * @brief build a priority queue of the elements in [first, last) in O(n), see push_range.
+   */
+  template<typename ForwardIt, typename = decltype(*std::declval<ForwardIt &>())>
+  priority_queue(ForwardIt first, ForwardIt last) : priority_queue() {
+    push_range(first, last);
+  }
+  /**
+   * @brief build a priority queue of the elements of v in O(n), see push_range.
+   */
+  explicit priority_queue(const vector<T> &v) : priority_queue(v.begin(), v.end()) {}
+
   /**
    * @brief copy constructor
    * @param other the priority_queue to be copied
    */
-  priority_queue(const priority_queue &other) {
-    size_ = other.size_;
-    head_ = static_cast<node *>(operator new(sizeof(node)));
-    if (other.empty()) {
-      head_->nxt_ = nullptr;
-      max_ = nullptr;
-      return;
-    }
-    head_->nxt_ = new node(other.head_->nxt_->val_);
-    DfsCopy(head_->nxt_, other.head_->nxt_);
-    node *tmp = other.head_;
-    max_ = head_;
-    while (tmp != other.max_) {
-      tmp = tmp->nxt_;
-      max_ = max_->nxt_;
+  priority_queue(const priority_queue &other) : priority_queue() {
+    if (!other.empty()) {
+      CopyFrom(other);
     }
-    cmp_ = Compare();
+  }
+
+  /**
+   * @brief move constructor, O(1)
+   * @param other the priority_queue to be moved from, empty afterwards
+   */
+  priority_queue(priority_queue &&other) noexcept : priority_queue() {
+    Steal(other);
   }
 
   /**
    * @brief deconstructor
    */
   ~priority_queue() {
-    if (head_->nxt_ != nullptr) {
-      DfsDeconstruct(head_->nxt_);
-    }
-    operator delete(head_);
+    Clear();
+    pool_type::release(pool_);
   }
 
   /**
@@ -80,23 +163,26 @@ public:
     if (this == &other) {
       return *this;
     }
-    if (head_->nxt_ != nullptr) {
-      DfsDeconstruct(head_->nxt_);
+    Clear();
+    if (!other.empty()) {
+      CopyFrom(other);
     }
-    size_ = other.size_;
-    if (other.empty()) {
-      head_->nxt_ = nullptr;
-      max_ = nullptr;
+    return *this;
+  }
+
+  /**
+   * @brief move assignment operator, O(1) apart from destroying the old elements
+   * @param other the priority_queue to be moved from, empty afterwards
+   * @return a reference to this priority_queue after assignment
+   */
+  priority_queue &operator=(priority_queue &&other) noexcept {
+    if (this == &other) {
       return *this;
     }
-    head_->nxt_ = new node(other.head_->nxt_->val_);
-    DfsCopy(head_->nxt_, other.head_->nxt_);
-    node *tmp = other.head_;
-    max_ = head_;
-    while (tmp != other.max_) {
-      tmp = tmp->nxt_;
-      max_ = max_->nxt_;
-    }
+    Clear();
+    pool_type::release(pool_);
+    pool_ = nullptr;
+    Steal(other);
     return *this;
   }
 
@@ -117,18 +203,80 @@ public:
    * @param e the element to be pushed
    */
   void push(const T &e) {
-    if (empty()) {
-      size_ = 1;
-      head_->nxt_ = new node(e);
-      max_ = head_->nxt_;
+    Insert(NewNode(e));
+  }
+  /**
+   * @brief push new element to the priority queue, moving it in.
+   * If Compare throws, the queue is unchanged but e has been moved from, and
+   * runtime_error is thrown.
+   * @param e the element to be pushed
+   */
+  void push(T &&e) {
+    Insert(NewNode(std::move(e)));
+  }
+  /**
+   * @brief construct a new element in place from args and push it.
+   * @param args the arguments passed to the constructor of T
+   */
+  template<typename... Args>
+  void emplace(Args &&...args) {
+    Insert(NewNode(std::forward<Args>(args)...));
+  }
+
+  /**
+   * @brief push the elements in [first, last) at once, in O(n + log(size())) instead
+   * of O(n) pushes. Their nodes are taken from one block of the pool and linked into
+   * binomial trees bottom-up, one comparison per link, then the new forest is merged
+   * in as by merge(). If copying an element or Compare throws, the queue is unchanged
+   * and runtime_error is thrown.
+   * @param first the first element to be pushed
+   * @param last the end of the range
+   */
+  template<typename ForwardIt, typename = decltype(*std::declval<ForwardIt &>())>
+  void push_range(ForwardIt first, ForwardIt last) {
+    size_t n = 0;
+    for (ForwardIt it = first; it != last; ++it) {
+      ++n;
+    }
+    if (n == 0) {
       return;
     }
-    priority_queue tmp(e);
-    vector<node *> root_val;
-    if (CheckMergeException(tmp, root_val)) {
+    Pool()->reserve(n);
+    node *roots = Build(first, last);
+    try {
+      if (!Lazy && !empty()) {
+        Meld(roots);
+      } else {
+        node *max = roots, *tail = roots;
+        for (node *cur = roots->nxt_; cur != nullptr; cur = cur->nxt_) {
+          if (cmp_(max->val_, cur->val_)) {
+            max = cur;
+          }
+          tail = cur;
+        }
+        if (empty()) {
+          head_.nxt_ = roots;
+          max_ = max;
+          tail_ = tail;
+        } else {
+          if (cmp_(max_->val_, max->val_)) {
+            max_ = max;
+          }
+          tail->nxt_ = head_.nxt_;
+          head_.nxt_ = roots;
+        }
+      }
+    } catch (...) {
+      DestroyForest<true>(roots);
       throw sjtu::runtime_error();
     }
-    MergeWithCheck(tmp, root_val, false);
+    size_ += n;
+  }
+  /**
+   * @brief push the elements of v at once, see push_range(first, last).
+   */
+  void push_range(const vector<T> &v) {
+    push_range(v.begin(), v.end());
   }
 
   /**
@@ -136,65 +284,24 @@ public:
    * @throws container_is_empty if empty() returns true
    */
   void pop() {
-    if (empty()) {
-      throw container_is_empty();
-    }
-    if (size() == 1) { // Remove the only node
-      delete max_;
-      size_ = 0;
-      head_->nxt_ = nullptr;
-      max_ = nullptr;
-      return;
-    }
-    node *las = head_;
-    while (las->nxt_ != max_) {
-      las = las->nxt_;
-    }
-    las->nxt_ = max_->nxt_;
-    size_ ^= (1 << max_->size_);
-    if (max_->size_ == 0) { // Remove a tree with a single node
-      if (empty()) {
-        delete max_;
-        max_ = nullptr;
-        head_->nxt_ = nullptr;
-        return;
-      }
-      node *rec = max_;
-      if (FindMax()) {
-        max_ = rec;
-        las->nxt_ = max_;
-        size_ ^= (1 << max_->size_);
-        throw sjtu::runtime_error();
-      }
-      delete rec;
-    } else if (head_->nxt_ == nullptr) { // Remove the root of the only tree
-      node *rec = max_;
-      head_->nxt_ = Next(max_->son_);
-      max_->son_->nxt_ = nullptr;
-      if (FindMax()) {
-        rec->son_ = Next(head_->nxt_);
-        head_->nxt_ = max_ = rec;
-        size_ ^= (1 << max_->size_);
-        throw sjtu::runtime_error();
-      }
-      size_ = (1 << rec->size_) - 1;
-      delete rec;
-    } else {
-      // clock_t begin = clock();
-      priority_queue tmp(max_->son_, (1 << max_->size_) - 1);
-      // clock_t end = clock();
-      // tot += end - begin;
-      vector<node *> root_val;
-      if (CheckMergeException(tmp, root_val)) {
-        las->nxt_ = max_;
-        size_ ^= (1 << max_->size_);
-        max_->son_ = Next(tmp.head_->nxt_);
-        tmp.head_->nxt_->nxt_ = nullptr;
-        tmp.head_->nxt_ = nullptr;
-        throw sjtu::runtime_error();
-      }
-      delete max_;
-      MergeWithCheck(tmp, root_val, false);
+    DeleteNode(Unlink());
+  }
+  /**
+   * @brief delete the top element from the priority queue and return it.
+   * The element is only moved out once the queue has been restructured, so an
+   * exception from Compare loses nothing.
+   * @return the former top element
+   * @throws container_is_empty if empty() returns true
+   */
+  T pop_value() {
+    node *top = Unlink();
+    try {
+      T value(std::move(top->val_));
+      DeleteNode(top);
+      return value;
+    } catch (...) {
+      DeleteNode(top);
+      throw;
     }
   }
 
@@ -214,6 +321,51 @@ public:
     return size_ == 0;
   }
 
+  /**
+   * @brief iterate over all elements in no particular order, without changing the queue.
+   */
+  const_iterator begin() const {
+    return const_iterator(head_.nxt_);
+  }
+  const_iterator end() const {
+    return const_iterator();
+  }
+
+  /**
+   * @brief replace the contents of out with all elements, the top first, moving
+   * them out, and empty the queue. O(n log n) like popping them all, but the values
+   * are sorted in one array instead of through the forest.
+   * If Compare may throw, pointers to the nodes are sorted instead and the values
+   * only moved once that succeeded, so an exception leaves the queue as it was and
+   * runtime_error is thrown.
+   * @param out the vector to receive the elements
+   */
+  void drain_sorted(vector<T> &out) {
+    if constexpr (kNoThrowCompare) {
+      out.assign(MoveValues<const_iterator>{begin()}, MoveValues<const_iterator>{end()});
+      sort(out, cmp_);
+      for (size_t i = 0, j = out.size(); i + 1 < j; ++i, --j) {
+        std::swap(out[i], out[j - 1]);
+      }
+    } else {
+      vector<node *> order;
+      order.reserve(size_);
+      for (const_iterator it = begin(); it != end(); ++it) {
+        order.push_back(it.cur_);
+      }
+      Compare &cmp = cmp_;
+      try {
+        sort(order, [&cmp](const node *a, const node *b) {
+          return cmp(b->val_, a->val_);
+        });
+      } catch (...) {
+        throw sjtu::runtime_error();
+      }
+      out.assign(MoveValues<node **>{order.data()}, MoveValues<node **>{order.data() + size_});
+    }
+    Clear();
+  }
+
   /**
    * @brief merge another priority_queue into this one.
    * The other priority_queue will be cleared after merging.
@@ -221,153 +373,538 @@ public:
    * @param other the priority_queue to be merged.
    */
   void merge(priority_queue &other) {
-    vector<node *> root_val;
-    MergeWithCheck(other, root_val); 
+    if (other.empty() || this == &other) {
+      return;
+    }
+    if (empty()) { // our pool holds no nodes, take over other's
+      pool_type::release(pool_);
+      Steal(other);
+      return;
+    }
+    if constexpr (Lazy) {
+      bool other_wins;
+      try {
+        other_wins = cmp_(max_->val_, other.max_->val_);
+      } catch (...) {
+        throw sjtu::runtime_error();
+      }
+      AdoptNodes(other);
+      tail_->nxt_ = other.head_.nxt_;
+      tail_ = other.tail_;
+      if (other_wins) {
+        max_ = other.max_;
+      }
+    } else {
+      Meld(other.head_.nxt_);
+      AdoptNodes(other);
+    }
+    other.head_.nxt_ = nullptr;
+    other.max_ = other.tail_ = nullptr;
+    size_ += other.size_;
+    other.size_ = 0;
+  }
+
+  /**
+   * @brief make room for n more elements, so that the next n pushes allocate no memory.
+   * @param n the number of elements.
+   */
+  void reserve(size_t n) {
+    Pool()->reserve(n);
+  }
+
+  /**
+   * @brief take the nodes of this priority_queue from the same pool as other.
+   * Queues sharing a pool merge without handing slabs over, but their destructors
+   * free node by node instead of releasing whole slabs.
+   * @param other the priority_queue whose pool is shared.
+   */
+  void share_pool(priority_queue &other) {
+    pool_type *root = other.Pool();
+    if (pool_ == nullptr) {
+      pool_ = pool_type::acquire(root);
+      return;
+    }
+    if (root == pool_->root()) {
+      return;
+    }
+    root->join(pool_->root()); // move the slabs holding our nodes over
+    pool_type *old = pool_;
+    pool_ = pool_type::acquire(root);
+    pool_type::release(old);
   }
-  
+
 private:
   size_t size_;
-  struct node {
+  // the part of a node the root list needs, so that head_ can be one without a value
+  struct link {
+    node *nxt_ = nullptr;
+  };
+  struct node : link {
     T val_;
     size_t size_ = 0; // actual size is 2 ^ size_
-    node *nxt_ = nullptr, *son_ = nullptr;
+    node *son_ = nullptr;
     node() = delete;
-    node(const T &val, node *son = nullptr) : val_(val), son_(son) {}
+    template<typename... Args>
+    explicit node(std::in_place_t, Args &&...args) : val_(std::forward<Args>(args)...) {}
   };
-  node *head_, *max_;
+  using pool_type = node_pool<node>;
+  /**
+   * Compare can never throw if its call is noexcept, or if it is std::less or
+   * std::greater on a scalar type (their operator() is not marked noexcept).
+   * Then merge and pop need no journal to undo a failed Consolidate.
+   */
+  static constexpr bool kNoThrowCompare =
+      noexcept(std::declval<Compare &>()(std::declval<const T &>(), std::declval<const T &>())) ||
+      (std::is_scalar<T>::value && (std::is_same<Compare, std::less<T>>::value ||
+                                    std::is_same<Compare, std::greater<T>>::value ||
+                                    std::is_same<Compare, std::less<>>::value ||
+                                    std::is_same<Compare, std::greater<>>::value));
+  link head_;
+  node *max_;
+  node *tail_; // the last root, only kept in lazy mode
   Compare cmp_;
+  pool_type *pool_; // nodes are carved from its slabs instead of one new per node, created on first use
 
-  node *Next(node *cur) {
-    if (cur->nxt_ == nullptr) {
-      return cur;
-    }
-    node *tmp = Next(cur->nxt_);
-    cur->nxt_->nxt_ = cur;
-    return tmp;
-  }
-  /** 
-  * Construct based on already-constructed trees
-  * The order is flipped
-  * max_ is not calculated
-  * Only used for pop()
-  */
-  priority_queue(node *cur, size_t size) : size_(size) { 
-    head_ = static_cast<node *>(operator new(sizeof(node)));
-    head_->nxt_ = Next(cur);
-    cur->nxt_ = nullptr;
-    cmp_ = Compare();
+  pool_type *Pool() {
+    if (pool_ == nullptr) {
+      pool_ = pool_type::create();
+    }
+    return pool_->root();
   }
-  /**
-  * Initially, *cur only has val.
-  */
-  void DfsCopy(node *cur, node *other) {
-    cur->size_ = other->size_;
-    if (other->nxt_ != nullptr) {
-      cur->nxt_ = new node(other->nxt_->val_);
-      DfsCopy(cur->nxt_, other->nxt_);
+  template<typename... Args>
+  node *NewNode(Args &&...args) {
+    pool_type *pool = Pool();
+    void *p = pool->allocate();
+    try {
+      return new(p) node(std::in_place, std::forward<Args>(args)...);
+    } catch (...) {
+      pool->deallocate(p);
+      throw;
     }
-    if (other->son_ != nullptr) {
-      cur->son_ = new node(other->son_->val_);
-      DfsCopy(cur->son_, other->son_);
+  }
+  void DeleteNode(node *x) {
+    x->~node();
+    pool_->root()->deallocate(x);
+  }
+  /**
+   * destroys all elements. When nobody else uses the pool its slabs are released
+   * whole, and for trivially destructible T the trees are not even walked.
+   */
+  void Clear() {
+    if (head_.nxt_ != nullptr) {
+      if (!pool_->exclusive()) {
+        DestroyForest<true>(head_.nxt_);
+      } else {
+        if (!std::is_trivially_destructible<T>::value) {
+          DestroyForest<false>(head_.nxt_);
+        }
+        pool_->reset();
+      }
     }
+    head_.nxt_ = nullptr;
+    max_ = tail_ = nullptr;
+    size_ = 0;
   }
-  void DfsDeconstruct(node *cur) {
-    if (cur->nxt_) {
-      DfsDeconstruct(cur->nxt_);
+  /**
+   * yields the values of the nodes It walks over as rvalues, so that
+   * vector::assign moves them.
+   */
+  template<typename It>
+  struct MoveValues {
+    It it_;
+    T &&operator*() const {
+      return std::move(NodeOf(it_)->val_);
     }
-    if (cur->son_) {
-      DfsDeconstruct(cur->son_);
+    MoveValues &operator++() {
+      ++it_;
+      return *this;
+    }
+    bool operator!=(const MoveValues &rhs) const {
+      return it_ != rhs.it_;
+    }
+    static node *NodeOf(const const_iterator &it) {
+      return it.cur_;
     }
-    delete cur;
+    static node *NodeOf(node *const *it) {
+      return *it;
+    }
+  };
+  void Steal(priority_queue &other) {
+    size_ = other.size_;
+    head_.nxt_ = other.head_.nxt_;
+    max_ = other.max_;
+    tail_ = other.tail_;
+    pool_ = other.pool_;
+    other.size_ = 0;
+    other.head_.nxt_ = nullptr;
+    other.max_ = other.tail_ = nullptr;
+    other.pool_ = nullptr;
   }
-  bool FindMax() {
+
+  /**
+   * links the new node x into the forest and takes ownership of it.
+   * If Compare throws, x is freed and runtime_error is thrown.
+   */
+  void Insert(node *x) {
+    if (empty()) {
+      size_ = 1;
+      head_.nxt_ = max_ = tail_ = x;
+      return;
+    }
+    if constexpr (Lazy) {
+      bool x_wins;
+      try {
+        x_wins = cmp_(max_->val_, x->val_);
+      } catch (...) {
+        DeleteNode(x);
+        throw sjtu::runtime_error();
+      }
+      x->nxt_ = head_.nxt_;
+      head_.nxt_ = x;
+      if (x_wins) {
+        max_ = x;
+      }
+      ++size_;
+      return;
+    }
+    // The roots are sorted by rank, so x is carried exactly through the roots with
+    // ranks 0, 1, 2, ... at the front of the list. All comparisons are made first,
+    // remembering in bit i whether the i-th of those roots stays on top, and only
+    // then is anything relinked, so an exception leaves the heap untouched.
+    node *winner = x, *rest = head_.nxt_;
+    size_t rank = 0, kept = 0;
+    bool max_linked = false;
     try {
-      max_ = head_->nxt_;
-      node *cur = max_;
-      while (cur != nullptr) {
-        if (cmp_(max_->val_, cur->val_)) {
-          max_ = cur;
+      for (; rest != nullptr && rest->size_ == rank; rest = rest->nxt_, ++rank) {
+        if (cmp_(winner->val_, rest->val_)) {
+          winner = rest;
+          kept |= size_t(1) << rank;
         }
-        cur = cur->nxt_;
+        max_linked |= rest == max_;
+      }
+      if (max_linked) {
+        max_ = winner;
+      } else if (cmp_(max_->val_, winner->val_)) {
+        max_ = winner;
       }
     } catch (...) {
-      return true;
+      DeleteNode(x);
+      throw sjtu::runtime_error();
+    }
+    node *tree = x, *root = head_.nxt_;
+    for (size_t i = 0; i < rank; ++i) {
+      node *nxt = root->nxt_;
+      if (kept >> i & 1) { // tree becomes root's first son
+        tree->nxt_ = root->son_;
+        root->son_ = tree;
+        tree = root;
+      } else { // root becomes tree's first son
+        root->nxt_ = tree->son_;
+        tree->son_ = root;
+      }
+      tree->size_ = i + 1;
+      root = nxt;
     }
-    return false;
+    tree->nxt_ = rest;
+    head_.nxt_ = tree;
+    ++size_;
   }
-  bool CheckMergeException(const priority_queue &other, vector<node *> &root_val) {
-    node *cur = head_, *cur_prime = other.head_->nxt_;
-    while (cur->nxt_ != nullptr && cur_prime != nullptr) {
-      if (cur->nxt_->size_ > cur_prime->size_) { 
-        root_val.push_back(cur_prime);
-        cur_prime = cur_prime->nxt_;
+  /**
+   * takes the top node out of the forest and returns it, its value untouched.
+   * If Compare throws, the forest is restored and runtime_error is thrown.
+   */
+  node *Unlink() {
+    if (empty()) {
+      throw container_is_empty();
+    }
+    node *top = max_;
+    if (size() == 1) { // Remove the only node
+      size_ = 0;
+      head_.nxt_ = nullptr;
+      max_ = tail_ = nullptr;
+      return top;
+    }
+    if constexpr (Lazy) {
+      LazyUnlink();
+      return top;
+    }
+    link *las = &head_;
+    while (las->nxt_ != max_) {
+      las = las->nxt_;
+    }
+    las->nxt_ = max_->nxt_;
+    size_ ^= (size_t(1) << max_->size_);
+    if (max_->size_ == 0) { // Remove a tree with a single node
+      if (empty()) {
+        max_ = nullptr;
+        head_.nxt_ = nullptr;
+        return top;
       }
-      else { 
-        root_val.push_back(cur->nxt_); 
-        cur = cur->nxt_;
+      try {
+        FindMax();
+      } catch (...) {
+        max_ = top;
+        las->nxt_ = max_;
+        size_ ^= (size_t(1) << max_->size_);
+        throw sjtu::runtime_error();
       }
+    } else if (head_.nxt_ == nullptr) { // Remove the root of the only tree
+      head_.nxt_ = Next(top->son_);
+      try {
+        FindMax();
+      } catch (...) {
+        top->son_ = Next(head_.nxt_);
+        head_.nxt_ = max_ = top;
+        size_ ^= (size_t(1) << top->size_);
+        throw sjtu::runtime_error();
+      }
+      size_ = (size_t(1) << top->size_) - 1;
+    } else {
+      node *children = Next(top->son_);
+      try {
+        Meld(children);
+      } catch (...) {
+        top->son_ = Next(children);
+        las->nxt_ = max_ = top;
+        size_ ^= (size_t(1) << top->size_);
+        throw sjtu::runtime_error();
+      }
+      size_ += (size_t(1) << top->size_) - 1;
     }
-    while (cur->nxt_ != nullptr) { 
-      root_val.push_back(cur->nxt_); 
-      cur = cur->nxt_;
-    }
-    while (cur_prime != nullptr) {
-      root_val.push_back(cur_prime);
-      cur_prime = cur_prime->nxt_;
+    top->son_ = nullptr;
+    return top;
+  }
+
+  /**
+   * reverses the list starting at cur and returns its new first node.
+   */
+  node *Next(node *cur) {
+    node *prev = nullptr;
+    while (cur != nullptr) {
+      node *nxt = cur->nxt_;
+      cur->nxt_ = prev;
+      prev = cur;
+      cur = nxt;
     }
-    size_t size = root_val.size();
+    return prev;
+  }
+  /**
+   * copies the forest of other into this empty queue. The copy is made in preorder
+   * into one slab, so every node sits right before its first son.
+   * The stack holds, per level above the current node, the source sibling still to
+   * be copied and the copy it will follow; the depth of a binomial tree is its rank,
+   * so kMaxRank + 1 levels are enough.
+   * If copying an element throws, this queue is left empty and runtime_error is thrown.
+   */
+  void CopyFrom(const priority_queue &other) {
+    struct frame {
+      node *src_, *prev_;
+    } stack[kMaxRank + 1];
+    size_t depth = 0;
+    Pool()->reserve(other.size_);
+    node *src = other.head_.nxt_, *prev = nullptr;
+    bool as_son = false;
     try {
-      T max = root_val[0]->val_; 
-      node tmp = *root_val[0];
-      for (size_t i = 0; i + 1 < size; ++i) {
-        if (tmp.size_ != root_val[i + 1]->size_ || (i + 2 < size && tmp.size_ == root_val[i + 2]->size_)) {
-          if (cmp_(max, root_val[i]->val_)) {
-            max = root_val[i]->val_;
+      while (true) {
+        node *copy = NewNode(src->val_);
+        copy->size_ = src->size_;
+        if (prev == nullptr) {
+          head_.nxt_ = copy;
+        } else if (as_son) {
+          prev->son_ = copy;
+        } else {
+          prev->nxt_ = copy;
+        }
+        if (src == other.max_) {
+          max_ = copy;
+        }
+        if (src->son_ != nullptr) {
+          if (src->nxt_ != nullptr) {
+            stack[depth++] = {src->nxt_, copy};
           }
-          tmp = *root_val[i + 1];
+          src = src->son_;
+          as_son = true;
+        } else if (src->nxt_ != nullptr) {
+          src = src->nxt_;
+          as_son = false;
+        } else if (depth != 0) {
+          --depth;
+          src = stack[depth].src_;
+          copy = stack[depth].prev_;
+          as_son = false;
+        } else {
+          break;
+        }
+        prev = copy;
+      }
+    } catch (...) {
+      Clear();
+      throw sjtu::runtime_error();
+    }
+    size_ = other.size_;
+    if constexpr (Lazy) {
+      for (tail_ = head_.nxt_; tail_->nxt_ != nullptr; tail_ = tail_->nxt_) {}
+    }
+  }
+  /**
+   * destroys every node of the forest starting at cur, and gives the nodes back
+   * to the pool if Free. Without recursion: while cur has a son, the son is rotated
+   * up to take cur's place, so the nodes are reached along nxt_ only.
+   */
+  template<bool Free>
+  void DestroyForest(node *cur) {
+    while (cur != nullptr) {
+      if (cur->son_ != nullptr) {
+        node *son = cur->son_;
+        cur->son_ = son->nxt_;
+        son->nxt_ = cur;
+        cur = son;
+      } else {
+        node *nxt = cur->nxt_;
+        if (Free) {
+          DeleteNode(cur);
         } else {
-          if (!cmp_(tmp.val_, root_val[i + 1]->val_)) {
-            tmp = *root_val[i + 1];
+          cur->~node();
+        }
+        cur = nxt;
+      }
+    }
+  }
+  void FindMax() {
+    max_ = head_.nxt_;
+    for (node *cur = max_->nxt_; cur != nullptr; cur = cur->nxt_) {
+      if (cmp_(max_->val_, cur->val_)) {
+        max_ = cur;
+      }
+    }
+  }
+  /**
+   * makes binomial trees of the elements in [first, last), which is not empty, and
+   * returns them as a list sorted by rank. As in a binary counter, a new node is
+   * carried through bucket[0], bucket[1], ... linking with the tree waiting in each,
+   * so n elements take n - popcount(n) comparisons.
+   * If copying an element or Compare throws, the new nodes are freed and runtime_error
+   * is thrown.
+   */
+  template<typename ForwardIt>
+  node *Build(ForwardIt first, ForwardIt last) {
+    node *bucket[kMaxRank + 1] = {}, *tree = nullptr;
+    size_t high = 0;
+    try {
+      for (; first != last; ++first) {
+        tree = NewNode(*first);
+        size_t rank = 0;
+        for (; bucket[rank] != nullptr; ++rank) {
+          node *other = bucket[rank];
+          if (cmp_(tree->val_, other->val_)) {
+            std::swap(tree, other);
           }
-          ++tmp.size_;
+          bucket[rank] = nullptr;
+          other->nxt_ = tree->son_;
+          tree->son_ = other;
+          tree->size_ = rank + 1;
         }
+        bucket[rank] = tree;
+        tree = nullptr;
+        high = rank > high ? rank : high;
       }
-      cmp_(max, tmp.val_);
     } catch (...) {
-      return true;
+      if (tree != nullptr) {
+        DestroyForest<true>(tree);
+      }
+      for (size_t rank = 0; rank <= high; ++rank) {
+        if (bucket[rank] != nullptr) {
+          DestroyForest<true>(bucket[rank]);
+        }
+      }
+      throw sjtu::runtime_error();
     }
-    return false;
+    link list, *las = &list;
+    for (size_t rank = 0; rank <= high; ++rank) {
+      if (bucket[rank] != nullptr) {
+        las->nxt_ = bucket[rank];
+        las = bucket[rank];
+      }
+    }
+    return list.nxt_;
   }
-  
-  void MergeWithCheck(priority_queue &other, vector<node *> &root_val, bool flag = true) {
-    if (other.empty()) {
+  /**
+   * the nodes of other are about to become ours, so are the slabs holding them.
+   */
+  void AdoptNodes(priority_queue &other) {
+    if (other.pool_ == nullptr) {
       return;
     }
-    if (empty()) {
-      size_ = other.size_;
-      head_->nxt_ = other.head_->nxt_;
-      max_ = other.max_;
-      other.size_ = 0;
-      other.head_->nxt_ = nullptr;
-      return;
+    pool_type *root = Pool(), *other_root = other.pool_->root();
+    if (root != other_root) {
+      root->join(other_root);
     }
-    
-    if (flag) { // Check exceptions
-      if (CheckMergeException(other, root_val)) {
+  }
+  /**
+   * merges the rank-sorted list starting at roots into the forest, every comparison
+   * made once. If Compare may throw, the links of all roots of both lists are first
+   * written to a journal; should Consolidate throw halfway, the journal is played
+   * back, which leaves the forest, max_ and the list starting at roots exactly as
+   * they were, and runtime_error is thrown.
+   * Both lists have at most kMaxRank roots, so the journal has a fixed size.
+   */
+  void Meld(node *roots) {
+    if constexpr (kNoThrowCompare) {
+      Splice(roots);
+      Consolidate();
+    } else {
+      struct entry {
+        node *node_, *nxt_, *son_;
+        size_t size_;
+      } journal[2 * kMaxRank];
+      size_t count = 0;
+      for (node *cur = head_.nxt_; cur != nullptr; cur = cur->nxt_) {
+        journal[count++] = {cur, cur->nxt_, cur->son_, cur->size_};
+      }
+      for (node *cur = roots; cur != nullptr; cur = cur->nxt_) {
+        journal[count++] = {cur, cur->nxt_, cur->son_, cur->size_};
+      }
+      node *first = head_.nxt_, *max = max_;
+      Splice(roots);
+      try {
+        Consolidate();
+      } catch (...) {
+        for (size_t i = 0; i < count; ++i) {
+          journal[i].node_->nxt_ = journal[i].nxt_;
+          journal[i].node_->son_ = journal[i].son_;
+          journal[i].node_->size_ = journal[i].size_;
+        }
+        head_.nxt_ = first;
+        max_ = max;
         throw sjtu::runtime_error();
       }
     }
-    
-    // Merge the root chain
-    head_->nxt_ = root_val[0];
-    size_t size = root_val.size();
-    for (size_t i = 0; i + 1 < size; ++i) {
-      root_val[i]->nxt_ = root_val[i + 1];
+  }
+  /**
+   * merges the rank-sorted list starting at roots into the root list, keeping it
+   * sorted by rank. Nothing is compared, so this cannot throw.
+   */
+  void Splice(node *roots) {
+    link *tail = &head_;
+    node *cur = head_.nxt_;
+    while (cur != nullptr && roots != nullptr) {
+      if (roots->size_ < cur->size_) {
+        tail->nxt_ = roots;
+        roots = roots->nxt_;
+      } else {
+        tail->nxt_ = cur;
+        cur = cur->nxt_;
+      }
+      tail = tail->nxt_;
     }
-    other.head_->nxt_ = nullptr;
-    
-    node *las = head_;
-    node *cur = head_->nxt_;
+    tail->nxt_ = cur != nullptr ? cur : roots;
+  }
+  /**
+   * links trees of equal rank until all ranks differ and finds the new max_.
+   */
+  void Consolidate() {
+    link *las = &head_;
+    node *cur = head_.nxt_;
     max_ = cur; 
     while (cur->nxt_ != nullptr) {
       // Two different trees or three trees with same size
@@ -397,8 +934,106 @@ private:
     if (cmp_(max_->val_, cur->val_)) {
       max_ = cur;
     }
-    size_ += other.size_;
-    other.size_ = 0;
+  }
+  /**
+   * the lazy pop: takes max_, which is not the only node, out of the root list and
+   * consolidates the other roots together with the sons of max_.
+   * If Compare may throw, the links of all those trees are first written to a
+   * journal, as in Meld, but of any length, since the lazy root list is not bounded.
+   */
+  void LazyUnlink() {
+    node *top = max_;
+    if constexpr (kNoThrowCompare) {
+      RemoveRoot(top);
+      Gather(head_.nxt_, top->son_);
+    } else {
+      struct entry {
+        node *node_, *nxt_, *son_;
+        size_t size_;
+      };
+      size_t count = top->size_;
+      for (node *cur = head_.nxt_; cur != nullptr; cur = cur->nxt_) {
+        ++count;
+      }
+      entry *journal = static_cast<entry *>(operator new [] (count * sizeof(entry)));
+      count = 0;
+      for (node *cur = head_.nxt_; cur != nullptr; cur = cur->nxt_) {
+        journal[count++] = {cur, cur->nxt_, cur->son_, cur->size_};
+      }
+      for (node *cur = top->son_; cur != nullptr; cur = cur->nxt_) {
+        journal[count++] = {cur, cur->nxt_, cur->son_, cur->size_};
+      }
+      node *first = head_.nxt_, *tail = tail_;
+      RemoveRoot(top);
+      try {
+        Gather(head_.nxt_, top->son_);
+      } catch (...) {
+        for (size_t i = 0; i < count; ++i) {
+          journal[i].node_->nxt_ = journal[i].nxt_;
+          journal[i].node_->son_ = journal[i].son_;
+          journal[i].node_->size_ = journal[i].size_;
+        }
+        operator delete [] (journal);
+        head_.nxt_ = first;
+        max_ = top;
+        tail_ = tail;
+        throw sjtu::runtime_error();
+      }
+      operator delete [] (journal);
+    }
+    --size_;
+  }
+  void RemoveRoot(node *x) {
+    link *las = &head_;
+    while (las->nxt_ != x) {
+      las = las->nxt_;
+    }
+    las->nxt_ = x->nxt_;
+  }
+  /**
+   * links the trees of the lists a and b, of any ranks in any order, in one pass:
+   * a tree of rank r waits in bucket[r] until another one of that rank comes.
+   * The trees left in the buckets become the new root list, sorted by rank, and
+   * max_ and tail_ are found on the way.
+   */
+  void Gather(node *a, node *b) {
+    node *bucket[kMaxRank + 1] = {};
+    node *lists[2] = {a, b};
+    size_t high = 0;
+    for (node *list : lists) {
+      for (node *cur = list; cur != nullptr;) {
+        node *tree = cur;
+        cur = cur->nxt_;
+        size_t rank = tree->size_;
+        for (; bucket[rank] != nullptr; ++rank) {
+          node *other = bucket[rank];
+          bucket[rank] = nullptr;
+          if (cmp_(tree->val_, other->val_)) {
+            std::swap(tree, other);
+          }
+          other->nxt_ = tree->son_;
+          tree->son_ = other;
+          tree->size_ = rank + 1;
+        }
+        bucket[rank] = tree;
+        high = rank > high ? rank : high;
+      }
+    }
+    link *las = &head_;
+    max_ = nullptr;
+    for (size_t rank = 0; rank <= high; ++rank) {
+      node *tree = bucket[rank];
+      if (tree == nullptr) {
+        continue;
+      }
+      if (max_ == nullptr || cmp_(max_->val_, tree->val_)) {
+        max_ = tree;
+      }
+      las->nxt_ = tree;
+      las = tree;
+    }
+    las->nxt_ = nullptr;
+    tail_ = static_cast<node *>(las);
   }
 };
 
@@ -0,0 +1,182 @@
+// radix heap for monotone unsigned keys
+// Reference : Ahuja, Mehlhorn, Orlin and Tarjan, "Faster algorithms for the shortest path problem"
+
+#ifndef SJTU_RADIX_HEAP_HPP
+#define SJTU_RADIX_HEAP_HPP
+
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include "exceptions.hpp"
+#include "../../vector/src/vector.hpp"
+
+namespace sjtu {
+/**
+ * @brief a min-priority queue of (key, value) pairs with unsigned integer keys that
+ * are taken out in non-decreasing order, as in Dijkstra or an event simulation.
+ * Keys are never compared with each other to place an element: bucket 0 holds the
+ * elements whose key equals last_, the key last returned by top() or pop(), and
+ * bucket i holds those whose highest bit differing from last_ is bit i - 1. When
+ * bucket 0 runs empty, the first non-empty bucket is spread over the lower ones
+ * around its smallest key. An element moves down at most once per bit, so push is
+ * O(1) and pop O(log C) amortized, C being the largest key.
+ * **Exception Safety**: push throws runtime_error, and changes nothing, for a key
+ * less than the key last returned by top() or pop(). If copying an element throws while
+ * a bucket is spread, the heap is left as it was. Moving Value must not throw.
+ */
+template<typename Key, typename Value>
+class radix_heap {
+  static_assert(std::is_unsigned<Key>::value, "radix_heap needs an unsigned integer key");
+
+public:
+  /**
+   * a key with its value, laid out like sjtu::pair but assignable, as sjtu::vector needs.
+   */
+  struct value_type {
+    Key first;
+    Value second;
+  };
+
+  /**
+   * @brief default constructor
+   */
+  radix_heap() = default;
+  radix_heap(const radix_heap &other) = default;
+  radix_heap &operator=(const radix_heap &other) = default;
+  /**
+   * @brief move constructor, O(number of buckets)
+   * @param other the radix_heap to be moved from, empty afterwards
+   */
+  radix_heap(radix_heap &&other) noexcept {
+    Steal(other);
+  }
+  radix_heap &operator=(radix_heap &&other) noexcept {
+    if (this != &other) {
+      for (size_t i = 0; i <= kBits; ++i) {
+        buckets_[i].clear();
+      }
+      Steal(other);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief get the element with the smallest key.
+   * From now on, no key less than top().first may be pushed.
+   * @return a reference of the top element.
+   * @throws container_is_empty if empty() returns true
+   */
+  const value_type & top() const {
+    Refill();
+    return buckets_[0][front_];
+  }
+
+  /**
+   * @brief push new element to the heap.
+   * @param key the key, not less than the key last returned by top() or pop()
+   * @param value the value stored with it
+   * @throws runtime_error if key is less than that key
+   */
+  void push(const Key &key, const Value &value) {
+    if (key < last_) {
+      throw runtime_error();
+    }
+    buckets_[Bucket(key)].push_back(value_type{key, value});
+    ++size_;
+  }
+
+  /**
+   * @brief delete the element with the smallest key.
+   * @throws container_is_empty if empty() returns true
+   */
+  void pop() {
+    Refill();
+    // the popped pairs stay constructed until the whole bucket is used up
+    if (++front_ == buckets_[0].size()) {
+      buckets_[0].clear();
+      front_ = 0;
+    }
+    --size_;
+  }
+
+  /**
+   * @brief return the number of elements in the heap.
+   * @return the number of elements.
+   */
+  size_t size() const {
+    return size_;
+  }
+
+  /**
+   * @brief check if the container is empty.
+   * @return true if it is empty, false otherwise.
+   */
+  bool empty() const {
+    return size_ == 0;
+  }
+
+private:
+  static constexpr size_t kBits = std::numeric_limits<Key>::digits;
+  // refilled by top() as well, which does not change the elements
+  mutable vector<value_type> buckets_[kBits + 1];
+  mutable size_t front_ = 0; // the pairs of bucket 0 before front_ have been popped
+  mutable Key last_ = 0;
+  size_t size_ = 0;
+
+  size_t Bucket(Key key) const {
+    return std::bit_width(static_cast<Key>(key ^ last_));
+  }
+  void Steal(radix_heap &other) {
+    for (size_t i = 0; i <= kBits; ++i) {
+      buckets_[i].swap(other.buckets_[i]);
+    }
+    front_ = other.front_;
+    last_ = other.last_;
+    size_ = other.size_;
+    other.front_ = 0;
+    other.last_ = 0;
+    other.size_ = 0;
+  }
+  /**
+   * makes sure that bucket 0 has an element left, by moving last_ up to the smallest
+   * key of the first non-empty bucket and spreading that bucket over the lower ones,
+   * all of which are empty.
+   */
+  void Refill() const {
+    if (empty()) {
+      throw container_is_empty();
+    }
+    if (front_ < buckets_[0].size()) {
+      return;
+    }
+    size_t i = 1;
+    while (buckets_[i].empty()) {
+      ++i;
+    }
+    vector<value_type> &from = buckets_[i];
+    Key old = last_, low = from[0].first;
+    for (size_t j = 1; j < from.size(); ++j) {
+      low = from[j].first < low ? from[j].first : low;
+    }
+    last_ = low;
+    try {
+      for (size_t j = 0; j < from.size(); ++j) {
+        buckets_[Bucket(from[j].first)].push_back(from[j]);
+      }
+    } catch (...) {
+      for (size_t j = 0; j < i; ++j) {
+        buckets_[j].clear();
+      }
+      last_ = old;
+      throw;
+    }
+    from.clear();
+    front_ = 0;
+  }
+};
+
+}
+
+#endif
@@ -0,0 +1,261 @@
+// bounded selection of the k best elements of a stream
+
+#ifndef SJTU_TOP_K_HPP
+#define SJTU_TOP_K_HPP
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+#include "exceptions.hpp"
+#include "../../vector/src/vector.hpp"
+#include "../../vector/src/sort.hpp"
+
+namespace sjtu {
+/**
+ * @brief keeps the k largest elements by Compare (the ones sjtu::priority_queue would
+ * pop first) of everything pushed into it, in one array of k elements allocated up front.
+ * The array is a binary heap with the worst kept element, the threshold, on top, so a
+ * push that is no better than the threshold is rejected after one comparison, and a
+ * better one replaces it in O(log k). Nothing is allocated after construction except by
+ * merge and drain_sorted.
+ * **Exception Safety**: every comparison of push is made before an element moves, so
+ * if Compare throws, the container is left as it was; merge and drain_sorted give the
+ * same guarantee.
+ * Moving T must not throw.
+ */
+template<typename T, class Compare = std::less<T>>
+class top_k {
+public:
+  /**
+   * @param k the number of elements to keep
+   */
+  explicit top_k(size_t k) : k_(k) {
+    data_ = k == 0 ? nullptr : std::allocator<T>().allocate(k);
+  }
+  /**
+   * if copying an element throws, the destructor frees what was built, since the
+   * delegated constructor has already completed.
+   */
+  top_k(const top_k &other) : top_k(other.k_) {
+    for (; size_ < other.size_; ++size_) {
+      new(&data_[size_]) T(other.data_[size_]);
+    }
+  }
+  top_k(top_k &&other) noexcept : k_(other.k_), size_(other.size_), data_(other.data_) {
+    other.k_ = other.size_ = 0;
+    other.data_ = nullptr;
+  }
+  top_k &operator=(top_k other) noexcept {
+    swap(other);
+    return *this;
+  }
+  ~top_k() {
+    Release();
+  }
+  void swap(top_k &other) noexcept {
+    std::swap(k_, other.k_);
+    std::swap(size_, other.size_);
+    std::swap(data_, other.data_);
+  }
+
+  /**
+   * @brief offer an element.
+   * @param e the element
+   * @return whether e is kept, which it is if fewer than k elements are kept or it is
+   * better than the threshold; the threshold is dropped then.
+   */
+  bool push(const T &e) {
+    if (size_ < k_) {
+      PushUp(e);
+      return true;
+    }
+    if (k_ == 0 || !cmp_(data_[0], e)) {
+      return false;
+    }
+    ReplaceTop(e);
+    return true;
+  }
+
+  /**
+   * @brief the worst of the kept elements, which the next element has to beat once full().
+   * @throws container_is_empty if empty() returns true
+   */
+  const T &threshold() const {
+    if (empty()) {
+      throw container_is_empty();
+    }
+    return data_[0];
+  }
+
+  /**
+   * @brief move every element of other in that is good enough; other becomes empty.
+   * The result is the same as pushing the elements of other one by one.
+   * Pointers to the elements of both are sorted, the best first, and only then are
+   * the k best moved into a new array, worst first, which makes it a valid heap. So
+   * nothing is copied, and if Compare throws, both containers are left as they were.
+   * @param other the top_k to be merged.
+   */
+  void merge(top_k &other) {
+    if (this == &other || other.empty()) {
+      return;
+    }
+    if (k_ == 0) {
+      other.clear();
+      return;
+    }
+    vector<T *> order;
+    order.reserve(size_ + other.size_);
+    // ours first, so that on a tie they stay, as they would against pushes
+    for (size_t i = 0; i < size_; ++i) {
+      order.push_back(data_ + i);
+    }
+    for (size_t i = 0; i < other.size_; ++i) {
+      order.push_back(other.data_ + i);
+    }
+    Compare &cmp = cmp_;
+    stable_sort(order, [&cmp](const T *a, const T *b) {
+      return cmp(*b, *a);
+    });
+    size_t n = order.size() < k_ ? order.size() : k_;
+    T *result = std::allocator<T>().allocate(k_);
+    for (size_t i = 0; i < n; ++i) {
+      new(&result[i]) T(std::move(*order[n - 1 - i]));
+    }
+    Release();
+    data_ = result;
+    size_ = n;
+    other.clear();
+  }
+
+  /**
+   * @brief replace the contents of out with the kept elements, the best first, moving
+   * them out, and empty this container.
+   * Pointers to the elements are sorted and the values only moved once that succeeded,
+   * so if Compare throws, this container and out are left as they were.
+   */
+  void drain_sorted(vector<T> &out) {
+    vector<T *> order;
+    order.reserve(size_);
+    for (size_t i = 0; i < size_; ++i) {
+      order.push_back(data_ + i);
+    }
+    Compare &cmp = cmp_;
+    sort(order, [&cmp](const T *a, const T *b) {
+      return cmp(*b, *a);
+    });
+    out.assign(MoveValues{order.data()}, MoveValues{order.data() + size_});
+    clear();
+  }
+
+  /**
+   * @brief the kept elements in no particular order.
+   */
+  const T *begin() const {
+    return data_;
+  }
+  const T *end() const {
+    return data_ + size_;
+  }
+
+  void clear() {
+    for (size_t i = 0; i < size_; ++i) {
+      data_[i].~T();
+    }
+    size_ = 0;
+  }
+  size_t size() const {
+    return size_;
+  }
+  /**
+   * @brief k, the most elements kept.
+   */
+  size_t capacity() const {
+    return k_;
+  }
+  bool empty() const {
+    return size_ == 0;
+  }
+  bool full() const {
+    return size_ == k_;
+  }
+
+private:
+  // a path from the root to a leaf of a binary heap visits at most this many levels
+  static constexpr size_t kMaxDepth = sizeof(size_t) * 8;
+  size_t k_, size_ = 0;
+  T *data_;
+  Compare cmp_;
+
+  /**
+   * yields the elements the pointers It walks over point to as rvalues, so that
+   * vector::assign moves them.
+   */
+  struct MoveValues {
+    T *const *it_;
+    T &&operator*() const {
+      return std::move(**it_);
+    }
+    MoveValues &operator++() {
+      ++it_;
+      return *this;
+    }
+    bool operator!=(const MoveValues &rhs) const {
+      return it_ != rhs.it_;
+    }
+  };
+  void Release() {
+    clear();
+    if (data_ != nullptr) {
+      std::allocator<T>().deallocate(data_, k_);
+    }
+  }
+  /**
+   * adds e in a free slot. First finds how far up e goes, where no parent is worse
+   * than e, then moves the parents on the way down and copies e in.
+   */
+  void PushUp(const T &e) {
+    size_t target = size_;
+    while (target > 0 && cmp_(e, data_[(target - 1) / 2])) {
+      target = (target - 1) / 2;
+    }
+    T value(e);
+    size_t hole = size_;
+    if (hole != target) {
+      new(&data_[hole]) T(std::move(data_[(hole - 1) / 2]));
+      for (hole = (hole - 1) / 2; hole != target; hole = (hole - 1) / 2) {
+        data_[hole] = std::move(data_[(hole - 1) / 2]);
+      }
+      data_[target] = std::move(value);
+    } else {
+      new(&data_[hole]) T(std::move(value));
+    }
+    ++size_;
+  }
+  /**
+   * replaces the threshold by e, which is better. First walks down along the worse
+   * child while it is worse than e, remembering the path, then shifts the path up.
+   */
+  void ReplaceTop(const T &e) {
+    size_t path[kMaxDepth + 1], depth = 0, cur = 0;
+    path[0] = 0;
+    for (size_t child = 1; child < size_; child = 2 * cur + 1) {
+      if (child + 1 < size_ && cmp_(data_[child + 1], data_[child])) {
+        ++child;
+      }
+      if (!cmp_(data_[child], e)) {
+        break;
+      }
+      path[++depth] = cur = child;
+    }
+    T value(e);
+    for (size_t i = 0; i < depth; ++i) {
+      data_[path[i]] = std::move(data_[path[i + 1]]);
+    }
+    data_[path[depth]] = std::move(value);
+  }
+};
+
+}
+
+#endif
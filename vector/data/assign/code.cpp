@@ -0,0 +1,162 @@
+#include "vector.hpp"
+
+#include <iostream>
+#include <string>
+
+// counts live objects and the constructions/assignments made on them
+class Tracked {
+public:
+	static int alive, constructed, assigned;
+	static int throw_after; // copying throws once this many copies are made, if not negative
+	int value;
+	Tracked(int v) : value(v) {
+		++alive;
+		++constructed;
+	}
+	Tracked(const Tracked &other) : value(other.value) {
+		if (throw_after == 0) {
+			throw sjtu::runtime_error();
+		}
+		if (throw_after > 0) {
+			--throw_after;
+		}
+		++alive;
+		++constructed;
+	}
+	Tracked &operator=(const Tracked &other) {
+		value = other.value;
+		++assigned;
+		return *this;
+	}
+	~Tracked() {
+		--alive;
+	}
+	static void Reset() {
+		constructed = assigned = 0;
+	}
+};
+int Tracked::alive = 0, Tracked::constructed = 0, Tracked::assigned = 0, Tracked::throw_after = -1;
+
+void Print(const sjtu::vector<Tracked> &v)
+{
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i].value << " ";
+	}
+	std::cout << "| size " << v.size() << " alive " << Tracked::alive
+		<< " constructed " << Tracked::constructed << " assigned " << Tracked::assigned << std::endl;
+}
+
+void TestCopyAssignment()
+{
+	std::cout << "Testing capacity-reusing copy assignment..." << std::endl;
+	sjtu::vector<Tracked> a, b, c;
+	for (int i = 0; i < 8; ++i) {
+		a.push_back(Tracked(i));
+		b.push_back(Tracked(-i));
+	}
+	for (int i = 0; i < 3; ++i) {
+		c.push_back(Tracked(100 + i));
+	}
+	Tracked::Reset();
+	b = a; // same size: assignments only
+	Print(b);
+	Tracked::Reset();
+	b = c; // shrink: assignments and destructions
+	Print(b);
+	Tracked::Reset();
+	b = a; // grow within capacity: assignments and constructions
+	Print(b);
+	sjtu::vector<Tracked> d;
+	Tracked::Reset();
+	d = a; // does not fit: one fresh buffer
+	Print(d);
+	d = d;
+	Print(d);
+}
+
+void TestAssign()
+{
+	std::cout << "Testing assign..." << std::endl;
+	sjtu::vector<std::string> v;
+	v.assign(4, "ab");
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << " ";
+	}
+	std::cout << std::endl;
+	v.assign(2, v[3]);
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << " ";
+	}
+	std::cout << std::endl;
+	sjtu::vector<std::string> w;
+	w.push_back("x");
+	w.push_back("y");
+	w.push_back("z");
+	v.assign(w.begin() + 1, w.end());
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << " ";
+	}
+	std::cout << std::endl;
+	v.assign(0, "unused");
+	std::cout << v.empty() << std::endl;
+	v.push_back("again");
+	std::cout << v.back() << std::endl;
+}
+
+void TestSwap()
+{
+	std::cout << "Testing swap..." << std::endl;
+	sjtu::vector<Tracked> a, b;
+	for (int i = 0; i < 5; ++i) {
+		a.push_back(Tracked(i));
+	}
+	b.push_back(Tracked(42));
+	Tracked::Reset();
+	a.swap(b);
+	Print(a);
+	swap(a, b);
+	Print(a);
+	Print(b);
+}
+
+void TestThrowingCopy()
+{
+	std::cout << "Testing a throwing copy..." << std::endl;
+	sjtu::vector<Tracked> a, d, f;
+	for (int i = 0; i < 8; ++i) {
+		a.push_back(Tracked(i));
+	}
+	f.push_back(Tracked(-1));
+	f.push_back(Tracked(-2));
+	f.reserve(16);
+	int base = Tracked::alive;
+	Tracked::throw_after = 3;
+	try {
+		d = a; // does not fit: the fresh buffer is thrown away
+	} catch (const sjtu::runtime_error &) {
+		std::cout << "fresh buffer: size " << d.size() << " leaked " << Tracked::alive - base << std::endl;
+	}
+	Tracked::throw_after = 3;
+	try {
+		sjtu::vector<Tracked> e(a);
+	} catch (const sjtu::runtime_error &) {
+		std::cout << "copy constructor: leaked " << Tracked::alive - base << std::endl;
+	}
+	Tracked::throw_after = 3;
+	try {
+		f = a; // fits: two assignments, then copies until one throws
+	} catch (const sjtu::runtime_error &) {
+		std::cout << "in place: size " << f.size() << " leaked " << Tracked::alive - base - (f.size() - 2) << std::endl;
+	}
+	Tracked::throw_after = -1;
+}
+
+int main()
+{
+	TestCopyAssignment();
+	TestAssign();
+	TestSwap();
+	TestThrowingCopy();
+	std::cout << "alive after destruction " << Tracked::alive << std::endl;
+	return 0;
+}
@@ -0,0 +1,58 @@
+// producer scaling of concurrent_vector::push_back against a mutex around sjtu::vector::push_back
+#include "../../../src/concurrent_vector.hpp"
+#include "../../../src/vector.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+template <class Func>
+long long TimeMicro(Func func) {
+  auto beg = std::chrono::high_resolution_clock::now();
+  func();
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - beg).count();
+}
+
+template <class Func>
+void RunProducers(int threads, Func func) {
+  std::vector<std::thread> producers;
+  for (int t = 0; t < threads; ++t) {
+    producers.emplace_back(func, t);
+  }
+  for (std::thread &p : producers) {
+    p.join();
+  }
+}
+
+int main() {
+  const int total = 8000000;
+  std::cout << total << " appends in total, times in us (" << std::thread::hardware_concurrency()
+            << " hardware threads)\n";
+  std::cout << "threads\tmutex+vector\tconcurrent_vector\n";
+  for (int threads : {1, 2, 4, 8, 16, 32}) {
+    int per_thread = total / threads;
+    long long locked = TimeMicro([&] {
+      sjtu::vector<int> v;
+      std::mutex mutex;
+      RunProducers(threads, [&](int t) {
+        for (int i = 0; i < per_thread; ++i) {
+          std::lock_guard<std::mutex> lock(mutex);
+          v.push_back(t + i);
+        }
+      });
+    });
+    long long lock_free = TimeMicro([&] {
+      sjtu::concurrent_vector<int> v;
+      RunProducers(threads, [&](int t) {
+        for (int i = 0; i < per_thread; ++i) {
+          v.push_back(t + i);
+        }
+      });
+    });
+    std::cout << threads << "\t" << locked << "\t\t" << lock_free << "\n";
+  }
+  return 0;
+}
@@ -0,0 +1,43 @@
+// compares sjtu::deque against using sjtu::vector::insert(0, x) / erase(0) as a queue
+#include "../../../src/deque.hpp"
+#include "../../../src/vector.hpp"
+
+#include <chrono>
+#include <iostream>
+
+template <class Func>
+long long TimeMicro(Func func) {
+  auto beg = std::chrono::high_resolution_clock::now();
+  func();
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - beg).count();
+}
+
+int main() {
+  for (int n : {1000, 10000, 50000}) {
+    long long checksum = 0;
+    long long vec = TimeMicro([&] {
+      sjtu::vector<int> v;
+      for (int i = 0; i < n; ++i) {
+        v.insert(0, i);
+      }
+      while (!v.empty()) {
+        checksum += v.back();
+        v.erase(0);
+      }
+    });
+    long long deq = TimeMicro([&] {
+      sjtu::deque<int> q;
+      for (int i = 0; i < n; ++i) {
+        q.push_front(i);
+      }
+      while (!q.empty()) {
+        checksum -= q.back();
+        q.pop_front();
+      }
+    });
+    std::cout << "n = " << n << ": vector front insert/erase " << vec << " us, deque " << deq
+              << " us (checksum " << checksum << ")\n";
+  }
+  return 0;
+}
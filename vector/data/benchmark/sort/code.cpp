@@ -0,0 +1,58 @@
+// compares sjtu::sort / stable_sort / radix_sort with std::sort and std::stable_sort
+#include "../../../src/sort.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+template <class Func>
+long long TimeMicro(Func func) {
+  auto beg = std::chrono::high_resolution_clock::now();
+  func();
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - beg).count();
+}
+
+std::vector<int> Make(const std::string &pattern, int n) {
+  std::mt19937 gen(2025);
+  std::vector<int> v(n);
+  for (int i = 0; i < n; ++i) {
+    if (pattern == "random") {
+      v[i] = static_cast<int>(gen());
+    } else if (pattern == "sorted") {
+      v[i] = i;
+    } else if (pattern == "reversed") {
+      v[i] = n - i;
+    } else {
+      v[i] = static_cast<int>(gen() % 16);
+    }
+  }
+  return v;
+}
+
+template <class Func>
+long long TimeOnCopy(const std::vector<int> &input, Func func) {
+  sjtu::vector<int> v;
+  v.assign(input.begin(), input.end());
+  return TimeMicro([&] { func(v); });
+}
+
+int main() {
+  const int n = 2000000;
+  std::cout << "n = " << n << ", times in us\n";
+  std::cout << "pattern     std::sort  sjtu::sort  std::stable  sjtu::stable  radix_sort\n";
+  for (std::string pattern : {"random", "sorted", "reversed", "duplicates"}) {
+    std::vector<int> input = Make(pattern, n);
+    std::vector<int> a = input, b = input;
+    long long std_sort = TimeMicro([&] { std::sort(a.begin(), a.end()); });
+    long long std_stable = TimeMicro([&] { std::stable_sort(b.begin(), b.end()); });
+    long long pdq = TimeOnCopy(input, [](sjtu::vector<int> &v) { sjtu::sort(v); });
+    long long stable = TimeOnCopy(input, [](sjtu::vector<int> &v) { sjtu::stable_sort(v); });
+    long long radix = TimeOnCopy(input, [](sjtu::vector<int> &v) { sjtu::radix_sort(v); });
+    std::cout << pattern << std::string(12 - pattern.size(), ' ') << std_sort << "\t" << pdq << "\t"
+              << std_stable << "\t" << stable << "\t" << radix << "\n";
+  }
+  return 0;
+}
@@ -0,0 +1,69 @@
+// size-ratio matrix for the sorted-set primitives against the std algorithms
+#include "../../../src/sorted_set.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <vector>
+
+template <class Func>
+long long TimeMicro(Func func) {
+  auto beg = std::chrono::high_resolution_clock::now();
+  func();
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - beg).count();
+}
+
+std::vector<int> MakeSet(std::mt19937 &gen, int n, int range) {
+  std::vector<int> v(n);
+  for (int &x : v) {
+    x = static_cast<int>(gen() % range);
+  }
+  std::sort(v.begin(), v.end());
+  v.erase(std::unique(v.begin(), v.end()), v.end());
+  return v;
+}
+
+int main() {
+  const int large_size = 4000000, rounds = 5;
+  std::mt19937 gen(2025);
+  std::cout << "|large| = " << large_size << ", times in us for " << rounds << " rounds\n";
+  std::cout << "ratio\top\t\tstd\tsjtu\n";
+  std::vector<int> large = MakeSet(gen, large_size, large_size * 4);
+  sjtu::vector<int> large_v;
+  large_v.assign(large.begin(), large.end());
+  for (int ratio : {1, 4, 16, 64, 256, 1024, 16384}) {
+    std::vector<int> small = MakeSet(gen, large_size / ratio, large_size * 4);
+    sjtu::vector<int> small_v, out;
+    small_v.assign(small.begin(), small.end());
+    std::vector<int> expect;
+    size_t checksum = 0;
+    auto report = [&](const char *name, auto std_op, auto sjtu_op) {
+      long long t_std = TimeMicro([&] {
+        for (int r = 0; r < rounds; ++r) {
+          expect.clear();
+          std_op(small.begin(), small.end(), large.begin(), large.end(), std::back_inserter(expect));
+        }
+      });
+      long long t_sjtu = TimeMicro([&] {
+        for (int r = 0; r < rounds; ++r) {
+          sjtu_op(small_v, large_v, out);
+        }
+      });
+      checksum += out.size() - expect.size();
+      std::cout << ratio << "\t" << name << "\t" << t_std << "\t" << t_sjtu << "\n";
+    };
+    report("intersection", [](auto... args) { std::set_intersection(args...); },
+           [](auto &a, auto &b, auto &o) { sjtu::set_intersection(a, b, o); });
+    report("union\t", [](auto... args) { std::set_union(args...); },
+           [](auto &a, auto &b, auto &o) { sjtu::set_union(a, b, o); });
+    report("difference", [](auto... args) { std::set_difference(args...); },
+           [](auto &a, auto &b, auto &o) { sjtu::set_difference(a, b, o); });
+    if (checksum != 0) {
+      std::cout << "size mismatch!\n";
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,177 @@
+#include "concurrent_vector.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <thread>
+#include <vector>
+
+const int kThreads = 8, kPerThread = 100000;
+
+// while fail_array_new is set, every array allocation (i.e. a new segment) throws
+bool fail_array_new = false;
+
+void *operator new [] (size_t size)
+{
+	void *p = fail_array_new ? nullptr : std::malloc(size == 0 ? 1 : size);
+	if (p == nullptr) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void operator delete [] (void *p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete [] (void *p, size_t) noexcept
+{
+	std::free(p);
+}
+
+// copying a Fragile throws once copies copies have been made, if copies is not negative
+struct Fragile {
+	static int copies;
+	int value;
+	Fragile(int v) : value(v) {}
+	Fragile(const Fragile &other) : value(other.value) {
+		if (copies == 0) {
+			throw sjtu::runtime_error();
+		}
+		if (copies > 0) {
+			--copies;
+		}
+	}
+};
+int Fragile::copies = -1;
+
+void TestProducers()
+{
+	std::cout << "Testing concurrent push_back..." << std::endl;
+	sjtu::concurrent_vector<long long> v;
+	std::atomic<bool> done(false);
+	std::atomic<long long> read_failures(0);
+	// a reader keeps checking already published elements while the vector grows
+	std::thread reader([&] {
+		while (!done.load()) {
+			size_t n = v.size();
+			for (size_t i = n > 100 ? n - 100 : 0; i < n; ++i) {
+				long long x = v[i];
+				if (x < 0 || x >= static_cast<long long>(kThreads) * kPerThread) {
+					++read_failures;
+				}
+			}
+		}
+	});
+	std::vector<std::thread> producers;
+	for (int t = 0; t < kThreads; ++t) {
+		producers.emplace_back([&v, t] {
+			for (int i = 0; i < kPerThread; ++i) {
+				v.push_back(static_cast<long long>(t) * kPerThread + i);
+			}
+		});
+	}
+	for (std::thread &p : producers) {
+		p.join();
+	}
+	done = true;
+	reader.join();
+	std::vector<int> seen(kThreads * kPerThread, 0);
+	for (size_t i = 0; i < v.size(); ++i) {
+		++seen[v[i]];
+	}
+	int bad = 0;
+	for (int c : seen) {
+		bad += c != 1;
+	}
+	std::cout << v.size() << " " << bad << " " << read_failures.load() << std::endl;
+}
+
+void TestGrowBy()
+{
+	std::cout << "Testing grow_by and references..." << std::endl;
+	sjtu::concurrent_vector<std::vector<int>> v;
+	size_t first = v.grow_by(5, std::vector<int>(3, 7));
+	std::vector<int> &ref = v[2];
+	for (int i = 0; i < 1000; ++i) {
+		v.push_back(std::vector<int>(1, i));
+	}
+	ref.push_back(8); // still the same object after growth
+	std::cout << first << " " << v.size() << " " << v[2].size() << " " << v[2][3] << " " << v[1004][0] << std::endl;
+	try {
+		v.at(1005);
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "index_out_of_bound" << std::endl;
+	}
+	v.clear();
+	std::cout << v.empty() << " " << v.push_back(std::vector<int>()) << std::endl;
+}
+
+void TestFailedAllocation()
+{
+	std::cout << "Testing a failed segment allocation..." << std::endl;
+	sjtu::concurrent_vector<int> v;
+	for (int i = 0; i < 8; ++i) {
+		v.push_back(i);
+	}
+	int caught = 0;
+	fail_array_new = true;
+	try {
+		v.push_back(8);
+	} catch (std::bad_alloc &) {
+		++caught;
+	}
+	try {
+		v.grow_by(3, 8);
+	} catch (std::bad_alloc &) {
+		++caught;
+	}
+	v.grow_by(0, 8);
+	fail_array_new = false;
+	std::cout << "caught " << caught << ", size " << v.size() << std::endl;
+	// nothing was claimed, so every index below size is readable without waiting
+	v.grow_by(20, 9);
+	long long sum = 0;
+	for (size_t i = 0; i < v.size(); ++i) {
+		sum += v[i];
+	}
+	std::cout << v.size() << " " << sum << std::endl;
+}
+
+void TestThrowingCopy()
+{
+	std::cout << "Testing a throwing copy in grow_by..." << std::endl;
+	sjtu::concurrent_vector<Fragile> v;
+	v.push_back(Fragile(1));
+	Fragile::copies = 5;
+	try {
+		v.grow_by(30, Fragile(2));
+	} catch (sjtu::runtime_error &) {
+		std::cout << "thrown" << std::endl;
+	}
+	Fragile::copies = -1;
+	v.push_back(Fragile(3));
+	// the claimed slots after the failed copy must not be waited on forever
+	int ready = 0, broken = 0;
+	long long sum = 0;
+	for (size_t i = 0; i < v.size(); ++i) {
+		try {
+			sum += v[i].value;
+			++ready;
+		} catch (sjtu::runtime_error &) {
+			++broken;
+		}
+	}
+	std::cout << v.size() << " " << ready << " " << broken << " " << sum << std::endl;
+}
+
+int main()
+{
+	TestProducers();
+	TestGrowBy();
+	TestFailedAllocation();
+	TestThrowingCopy();
+	return 0;
+}
@@ -0,0 +1,109 @@
+#include "vector.hpp"
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+
+// every table below is computed by the compiler, the vectors only live during constant evaluation
+
+constexpr std::array<uint32_t, 256> MakeCrcTable()
+{
+	sjtu::vector<uint32_t> table;
+	for (uint32_t i = 0; i < 256; ++i) {
+		uint32_t c = i;
+		for (int k = 0; k < 8; ++k) {
+			c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+		}
+		table.push_back(c);
+	}
+	std::array<uint32_t, 256> result{};
+	size_t i = 0;
+	for (sjtu::vector<uint32_t>::const_iterator it = table.cbegin(); it != table.cend(); ++it) {
+		result[i++] = *it;
+	}
+	return result;
+}
+
+constexpr std::array<uint32_t, 256> kCrcTable = MakeCrcTable();
+static_assert(kCrcTable[0] == 0);
+static_assert(kCrcTable[1] == 0x77073096u);
+static_assert(kCrcTable[255] == 0x2D02EF8Du);
+
+constexpr uint32_t Crc32(const char *s)
+{
+	uint32_t c = 0xFFFFFFFFu;
+	for (; *s; ++s) {
+		c = kCrcTable[(c ^ static_cast<unsigned char>(*s)) & 0xFF] ^ (c >> 8);
+	}
+	return c ^ 0xFFFFFFFFu;
+}
+static_assert(Crc32("123456789") == 0xCBF43926u);
+
+// primes below n with a sieve that grows, shrinks and copies vectors
+template<size_t N>
+constexpr std::array<int, N> FirstPrimes()
+{
+	sjtu::vector<bool> composite(N * 20, false);
+	sjtu::vector<int> primes;
+	for (size_t i = 2; i < composite.size() && primes.size() < N; ++i) {
+		if (composite[i]) {
+			continue;
+		}
+		primes.push_back(static_cast<int>(i));
+		for (size_t j = i * i; j < composite.size(); j += i) {
+			composite[j] = true;
+		}
+	}
+	sjtu::vector<int> copy = primes;
+	copy.erase_if([](int x) { return x % 10 == 3; });
+	copy.insert(size_t(0), 3);
+	copy.insert(copy.begin() + 2, 13);
+	copy.remove(7);
+	copy.insert(copy.size(), copy[0]);
+	std::array<int, N> result{};
+	for (size_t i = 0; i < copy.size() && i < N; ++i) {
+		result[i] = copy.at(i);
+	}
+	return result;
+}
+
+constexpr std::array<int, 8> kPrimes = FirstPrimes<8>();
+// 2 3 5 7 11 13 17 19 -> drop 3, 13 -> 3 2 13 5 11 17 19 3 -> drop 7 (absent)
+static_assert(kPrimes[0] == 3 && kPrimes[1] == 2 && kPrimes[2] == 13 && kPrimes[3] == 5);
+static_assert(kPrimes[6] == 19 && kPrimes[7] == 3);
+
+constexpr int Members()
+{
+	sjtu::vector<int> v{5, 1, 4};
+	sjtu::vector<int> w(3, 7);
+	v.swap(w);
+	w.assign(v.begin(), v.end());
+	v.clear();
+	v.reserve(10);
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(i);
+	}
+	while (v.size() > 2) {
+		v.pop_back();
+	}
+	v.swap_remove(0);
+	return v.front() * 1000 + w.back() * 100 + static_cast<int>(w.size()) * 10 + (v.end() - v.begin());
+}
+static_assert(Members() == 1731);
+
+int main()
+{
+	std::cout << "Testing crc table..." << std::endl;
+	std::cout << std::hex << kCrcTable[1] << " " << kCrcTable[128] << " " << Crc32("The quick brown fox jumps over the lazy dog") << std::dec << std::endl;
+	std::cout << "Testing sieve..." << std::endl;
+	for (int p : kPrimes) {
+		std::cout << p << " ";
+	}
+	std::cout << std::endl;
+	std::cout << "Testing members..." << std::endl;
+	std::cout << Members() << std::endl;
+	// the same code still runs at run time
+	std::array<uint32_t, 256> runtime = MakeCrcTable();
+	std::cout << (runtime == kCrcTable ? "same" : "different") << std::endl;
+	return 0;
+}
@@ -0,0 +1,141 @@
+#include "vector.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+// counts allocations, sjtu::vector gets its buffer through std::allocator
+int allocations = 0;
+
+void *operator new(size_t size)
+{
+	++allocations;
+	if (void *p = std::malloc(size == 0 ? 1 : size)) {
+		return p;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+	std::free(p);
+}
+
+template<typename T>
+void Print(const char *name, const sjtu::vector<T> &v, int allocated)
+{
+	std::cout << name << ":";
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << " " << v[i];
+	}
+	std::cout << " | size " << v.size() << " capacity " << v.capacity() << " allocations " << allocated << std::endl;
+}
+
+struct Holder {
+	sjtu::vector<int> a, b, c;
+};
+
+void TestEmpty()
+{
+	std::cout << "Testing empty vectors..." << std::endl;
+	int before = allocations;
+	Holder h[100];
+	sjtu::vector<std::string> copy(h[0].a.size(), "unused");
+	sjtu::vector<int> copy_of_empty(h[1].b);
+	std::cout << "allocations for 302 empty vectors: " << allocations - before << std::endl;
+	sjtu::vector<int> v;
+	v.push_back(1);
+	v.push_back(2);
+	before = allocations;
+	v.pop_back();
+	v.pop_back();
+	std::cout << "allocations for the final pop_back: " << allocations - before << " capacity " << v.capacity() << std::endl;
+	v.push_back(3);
+	before = allocations;
+	v.clear();
+	v.push_back(4);
+	std::cout << "allocations for clear and push_back: " << allocations - before << " " << v.front() << std::endl;
+	try {
+		sjtu::vector<int>().pop_back();
+	} catch (sjtu::container_is_empty &) {
+		std::cout << "container_is_empty" << std::endl;
+	}
+}
+
+void TestExactConstruction()
+{
+	std::cout << "Testing exact-size construction..." << std::endl;
+	int before = allocations;
+	sjtu::vector<int> list = {5, 4, 3, 2, 1};
+	Print("initializer_list", list, allocations - before);
+	before = allocations;
+	sjtu::vector<std::string> fill(3, "ab");
+	Print("count+value", fill, allocations - before);
+	before = allocations;
+	sjtu::vector<int> range(list.begin() + 1, list.end());
+	Print("iterator range", range, allocations - before);
+	for (int i = 0; i < 100; ++i) {
+		list.push_back(i);
+	}
+	for (int i = 0; i < 95; ++i) {
+		list.erase(list.size() - 1);
+	}
+	before = allocations;
+	sjtu::vector<int> copy(list);
+	Print("copy", copy, allocations - before);
+}
+
+void TestInsertAliasing()
+{
+	std::cout << "Testing insert and push_back of own elements..." << std::endl;
+	sjtu::vector<std::string> v = {"a", "b", "c", "d"};
+	v.push_back(v[0]); // grows
+	v.insert(1, v[4]); // shifts within capacity
+	v.insert(0, v.back());
+	v.erase(2);
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << " ";
+	}
+	std::cout << std::endl;
+}
+
+// can be constructed from another one but not assigned
+struct Pinned {
+	const int id;
+	Pinned(int i) : id(i) {}
+	Pinned(const Pinned &other) = default;
+	Pinned &operator=(const Pinned &) = delete;
+};
+
+void TestNotAssignable()
+{
+	std::cout << "Testing insert and erase without assignment..." << std::endl;
+	sjtu::vector<Pinned> v;
+	for (int i = 0; i < 6; ++i) {
+		v.push_back(Pinned(i));
+	}
+	v.insert(2, Pinned(10));
+	v.insert(v.begin(), Pinned(11));
+	v.insert(v.size(), Pinned(12));
+	v.erase(4);
+	v.erase(v.begin());
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i].id << " ";
+	}
+	std::cout << std::endl;
+}
+
+int main()
+{
+	TestEmpty();
+	TestExactConstruction();
+	TestInsertAliasing();
+	TestNotAssignable();
+	return 0;
+}
@@ -0,0 +1,110 @@
+#include "deque.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+void TestBothEnds()
+{
+	std::cout << "Testing push and pop at both ends..." << std::endl;
+	sjtu::deque<int> q;
+	for (int i = 0; i < 20; ++i) {
+		if (i % 2 == 0) {
+			q.push_back(i);
+		} else {
+			q.push_front(i);
+		}
+	}
+	for (size_t i = 0; i < q.size(); ++i) {
+		std::cout << q[i] << " ";
+	}
+	std::cout << std::endl;
+	for (int i = 0; i < 5; ++i) {
+		q.pop_front();
+		q.pop_back();
+	}
+	std::cout << q.front() << " " << q.back() << " " << q.size() << std::endl;
+	// wrap around the buffer many times
+	long long sum = 0;
+	for (int i = 0; i < 100000; ++i) {
+		q.push_back(i);
+		sum += q.front();
+		q.pop_front();
+	}
+	std::cout << sum << " " << q.size() << std::endl;
+	q.push_front(q.back());
+	q.push_back(q.front());
+	std::cout << q.front() << " " << q.back() << std::endl;
+}
+
+void TestIterators()
+{
+	std::cout << "Testing iterators..." << std::endl;
+	sjtu::deque<int> q;
+	for (int i = 0; i < 10; ++i) {
+		q.push_front(i * 7 % 10);
+	}
+	std::sort(q.begin(), q.end());
+	for (sjtu::deque<int>::const_iterator it = q.cbegin(); it != q.cend(); ++it) {
+		std::cout << *it << " ";
+	}
+	std::cout << std::endl;
+	sjtu::deque<int>::iterator it = q.begin() + 3;
+	it[1] = 100;
+	*(it - 2) = -1;
+	std::cout << *it << " " << q[4] << " " << q[1] << " " << (q.end() - it) << " " << (it < q.end()) << std::endl;
+	sjtu::deque<int> other(q);
+	try {
+		std::cout << (other.begin() - q.begin()) << std::endl;
+	} catch (sjtu::invalid_iterator &) {
+		std::cout << "invalid_iterator" << std::endl;
+	}
+}
+
+void TestCopy()
+{
+	std::cout << "Testing copy and swap..." << std::endl;
+	sjtu::deque<std::string> a, b;
+	for (int i = 0; i < 12; ++i) {
+		a.push_front(std::to_string(i));
+	}
+	b = a;
+	a.pop_front();
+	a.swap(b);
+	std::cout << a.size() << " " << a.front() << " " << b.size() << " " << b.front() << std::endl;
+	const sjtu::deque<std::string> c(a);
+	std::cout << c.at(11) << " " << c.back() << std::endl;
+	a.clear();
+	std::cout << a.empty() << std::endl;
+}
+
+void TestExceptions()
+{
+	std::cout << "Testing exceptions..." << std::endl;
+	sjtu::deque<int> q;
+	try {
+		q.pop_front();
+	} catch (sjtu::container_is_empty &) {
+		std::cout << "container_is_empty" << std::endl;
+	}
+	try {
+		q.back();
+	} catch (sjtu::container_is_empty &) {
+		std::cout << "container_is_empty" << std::endl;
+	}
+	q.push_back(1);
+	try {
+		q.at(1);
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "index_out_of_bound" << std::endl;
+	}
+}
+
+int main()
+{
+	TestBothEnds();
+	TestIterators();
+	TestCopy();
+	TestExceptions();
+	return 0;
+}
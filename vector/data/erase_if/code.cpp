@@ -0,0 +1,94 @@
+#include "vector.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+int allocations = 0;
+
+void *operator new(size_t size)
+{
+	++allocations;
+	if (void *p = std::malloc(size == 0 ? 1 : size)) {
+		return p;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+	std::free(p);
+}
+
+template<typename T>
+void Print(const sjtu::vector<T> &v)
+{
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << " ";
+	}
+	std::cout << "| size " << v.size() << std::endl;
+}
+
+void TestEraseIf()
+{
+	std::cout << "Testing erase_if..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 20; ++i) {
+		v.push_back(i);
+	}
+	std::cout << v.erase_if([](int x) { return x % 3 == 0; }) << std::endl;
+	Print(v);
+	std::cout << v.erase_if([](int x) { return x > 100; }) << std::endl;
+	Print(v);
+	// filtering a large vector is linear and reallocates at most once
+	sjtu::vector<int> big;
+	for (int i = 0; i < 1000000; ++i) {
+		big.push_back(i);
+	}
+	int before = allocations;
+	std::cout << big.erase_if([](int x) { return x % 10 != 0; }) << " " << big.size() << " " << big[99999] << std::endl;
+	std::cout << "allocations: " << allocations - before << std::endl;
+	std::cout << big.erase_if([](int) { return true; }) << " " << big.empty() << " " << big.capacity() << std::endl;
+}
+
+void TestRemove()
+{
+	std::cout << "Testing remove..." << std::endl;
+	sjtu::vector<std::string> v = {"x", "a", "x", "b", "x", "c"};
+	std::cout << v.remove("x") << std::endl;
+	Print(v);
+	v.push_back("a");
+	std::cout << v.remove(v[0]) << std::endl;
+	Print(v);
+	std::cout << v.remove("missing") << std::endl;
+}
+
+void TestSwapRemove()
+{
+	std::cout << "Testing swap_remove..." << std::endl;
+	sjtu::vector<int> v = {0, 1, 2, 3, 4, 5};
+	std::cout << *v.swap_remove(1) << std::endl;
+	Print(v);
+	sjtu::vector<int>::iterator it = v.swap_remove(4);
+	std::cout << (it == v.end()) << std::endl;
+	Print(v);
+	try {
+		v.swap_remove(4);
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "index_out_of_bound" << std::endl;
+	}
+}
+
+int main()
+{
+	TestEraseIf();
+	TestRemove();
+	TestSwapRemove();
+	return 0;
+}
@@ -0,0 +1,188 @@
+#include "jagged_vector.hpp"
+
+#include <iostream>
+#include <string>
+
+// copying a Fragile throws once copies copies have been made, if copies is not negative
+struct Fragile {
+	static int copies;
+	int value;
+	Fragile(int v) : value(v) {}
+	Fragile(const Fragile &other) : value(other.value) {
+		if (copies == 0) {
+			throw sjtu::runtime_error();
+		}
+		if (copies > 0) {
+			--copies;
+		}
+	}
+	Fragile(Fragile &&other) noexcept = default;
+};
+int Fragile::copies = -1;
+
+void PrintRows(const sjtu::jagged_vector<int> &jv)
+{
+	for (size_t i = 0; i < jv.rows(); ++i) {
+		std::cout << i << ":";
+		for (const int &x : jv[i]) {
+			std::cout << " " << x;
+		}
+		std::cout << std::endl;
+	}
+}
+
+void TestAppend()
+{
+	std::cout << "Testing push_row and push_back..." << std::endl;
+	sjtu::jagged_vector<int> adj;
+	for (int i = 0; i < 6; ++i) {
+		adj.push_row();
+		for (int j = 0; j < i; ++j) {
+			adj.push_back(i * 10 + j);
+		}
+	}
+	sjtu::vector<int> v;
+	v.push_back(7);
+	v.push_back(8);
+	adj.push_row(v);
+	adj.push_row(3, -1);
+	PrintRows(adj);
+	std::cout << adj.rows() << " " << adj.size() << " " << adj.row_begin(6) << std::endl;
+	adj.pop_back();
+	adj.pop_row();
+	adj[2][1] = 100;
+	std::cout << adj.at(2, 1) << " " << adj.back().back() << " " << adj.size() << std::endl;
+	const sjtu::jagged_vector<int> copy(adj);
+	adj.clear();
+	std::cout << adj.empty() << " " << copy.rows() << std::endl;
+	PrintRows(copy);
+}
+
+void TestBulkBuild()
+{
+	std::cout << "Testing bulk build..." << std::endl;
+	sjtu::vector<size_t> sizes;
+	sizes.push_back(2);
+	sizes.push_back(0);
+	sizes.push_back(3);
+	sjtu::jagged_vector<int> jv(sizes, 5);
+	jv[2][0] = 1;
+	PrintRows(jv);
+	sjtu::jagged_vector<int> other;
+	other.push_row(4, 9);
+	swap(jv, other);
+	PrintRows(jv);
+	jv = other;
+	PrintRows(jv);
+}
+
+void TestStrings()
+{
+	std::cout << "Testing string table..." << std::endl;
+	sjtu::jagged_vector<std::string> table;
+	table.push_back("alpha");
+	table.push_back("");
+	table.push_back(std::string("gamma ray"));
+	for (size_t i = 0; i < table.size(); ++i) {
+		std::cout << "[" << table[i] << "] " << table.length(i) << " " << table.c_str(i) << std::endl;
+	}
+	table.pop_back();
+	std::cout << table.size() << std::endl;
+}
+
+void TestExceptions()
+{
+	std::cout << "Testing exceptions..." << std::endl;
+	sjtu::jagged_vector<int> jv;
+	try {
+		jv.push_back(1);
+	} catch (sjtu::container_is_empty &) {
+		std::cout << "container_is_empty" << std::endl;
+	}
+	jv.push_row(2, 1);
+	try {
+		jv[1];
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "index_out_of_bound" << std::endl;
+	}
+	try {
+		jv.at(0, 2);
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "index_out_of_bound" << std::endl;
+	}
+	jv.push_row();
+	try {
+		jv.pop_back();
+	} catch (sjtu::container_is_empty &) {
+		std::cout << "container_is_empty" << std::endl;
+	}
+}
+
+void TestAliasing()
+{
+	std::cout << "Testing values from the container itself..." << std::endl;
+	sjtu::jagged_vector<int> jv;
+	jv.push_row(1, 42);
+	for (int i = 0; i < 20; ++i) {
+		jv.push_back(jv.at(0, 0));
+	}
+	jv.push_row(jv[0].begin(), jv[0].end());
+	jv.push_row(5, jv.at(1, 3));
+	std::cout << jv.rows() << " " << jv.size() << " " << jv.at(1, 20) << " " << jv.at(2, 4) << std::endl;
+	sjtu::vector<size_t> sizes(3, 2);
+	jv.assign(sizes, jv.at(2, 0));
+	PrintRows(jv);
+	sjtu::jagged_vector<std::string> table;
+	table.push_back("self");
+	for (int i = 0; i < 10; ++i) {
+		table.push_back(table[table.size() - 1]);
+	}
+	std::cout << table.size() << " " << table[10] << std::endl;
+}
+
+void TestThrowingCopy()
+{
+	std::cout << "Testing a throwing copy..." << std::endl;
+	sjtu::jagged_vector<Fragile> jv;
+	sjtu::vector<Fragile> row;
+	for (int i = 0; i < 6; ++i) {
+		row.push_back(Fragile(i));
+	}
+	int caught = 0;
+	// the first rounds fit in the buffer, the later ones make it grow
+	for (int round = 0; round < 6; ++round) {
+		size_t rows = jv.rows(), size = jv.size();
+		Fragile::copies = 3;
+		try {
+			jv.push_row(row.begin(), row.end());
+		} catch (sjtu::runtime_error &) {
+			caught += jv.rows() == rows && jv.size() == size;
+		}
+		Fragile::copies = 2;
+		try {
+			jv.push_row(4, Fragile(9));
+		} catch (sjtu::runtime_error &) {
+			caught += jv.rows() == rows && jv.size() == size;
+		}
+		Fragile::copies = -1;
+		jv.push_row(2, Fragile(round));
+	}
+	int sum = 0;
+	for (size_t i = 0; i < jv.rows(); ++i) {
+		for (const Fragile &x : jv[i]) {
+			sum += x.value;
+		}
+	}
+	std::cout << "caught " << caught << ", " << jv.rows() << " " << jv.size() << " " << sum << std::endl;
+}
+
+int main()
+{
+	TestAppend();
+	TestBulkBuild();
+	TestStrings();
+	TestExceptions();
+	TestAliasing();
+	TestThrowingCopy();
+	return 0;
+}
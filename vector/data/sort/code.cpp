@@ -0,0 +1,212 @@
+#include "sort.hpp"
+
+#include <iostream>
+#include <string>
+
+unsigned int last = 233;
+
+unsigned int Rand()
+{
+	return last = last * 1103515245u + 12345u;
+}
+
+template<typename T, class Compare = std::less<T>>
+bool IsSorted(const sjtu::vector<T> &v, Compare comp = Compare())
+{
+	for (size_t i = 1; i < v.size(); ++i) {
+		if (comp(v[i], v[i - 1])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// pattern 0: random, 1: sorted, 2: reversed, 3: many duplicates, 4: organ pipe, 5: sorted with noise
+sjtu::vector<int> Make(int pattern, int n)
+{
+	sjtu::vector<int> v;
+	for (int i = 0; i < n; ++i) {
+		switch (pattern) {
+			case 0: v.push_back(static_cast<int>(Rand())); break;
+			case 1: v.push_back(i); break;
+			case 2: v.push_back(n - i); break;
+			case 3: v.push_back(Rand() % 4); break;
+			case 4: v.push_back(i < n / 2 ? i : n - i); break;
+			default: v.push_back(Rand() % 100 == 0 ? static_cast<int>(Rand() % n) : i); break;
+		}
+	}
+	return v;
+}
+
+long long Sum(const sjtu::vector<int> &v)
+{
+	long long sum = 0;
+	for (size_t i = 0; i < v.size(); ++i) {
+		sum += v[i];
+	}
+	return sum;
+}
+
+void TestSort()
+{
+	std::cout << "Testing sort..." << std::endl;
+	for (int pattern = 0; pattern < 6; ++pattern) {
+		for (int n : {0, 1, 2, 23, 24, 100, 1000, 100000}) {
+			sjtu::vector<int> v = Make(pattern, n), w = v, r = v;
+			long long sum = Sum(v);
+			sjtu::sort(v);
+			sjtu::sort(w, std::greater<int>());
+			sjtu::radix_sort(r);
+			if (!IsSorted(v) || !IsSorted(w, std::greater<int>()) || !IsSorted(r) || Sum(v) != sum || Sum(r) != sum) {
+				std::cout << "pattern " << pattern << " n " << n << " failed" << std::endl;
+			}
+		}
+	}
+	sjtu::vector<std::string> s;
+	for (int i = 0; i < 300; ++i) {
+		s.push_back(std::to_string(Rand() % 1000));
+	}
+	sjtu::sort(s);
+	std::cout << IsSorted(s) << " " << s[0] << " " << s[299] << std::endl;
+}
+
+struct Record {
+	int key, order;
+};
+
+void TestStableSort()
+{
+	std::cout << "Testing stable_sort..." << std::endl;
+	sjtu::vector<Record> v, r;
+	for (int i = 0; i < 5000; ++i) {
+		v.push_back(Record{static_cast<int>(Rand() % 50) - 25, i});
+	}
+	r = v;
+	auto by_key = [](const Record &a, const Record &b) { return a.key < b.key; };
+	sjtu::stable_sort(v, by_key);
+	sjtu::radix_sort(r, [](const Record &a) { return a.key; });
+	bool stable = true;
+	for (size_t i = 1; i < v.size(); ++i) {
+		if (v[i - 1].key > v[i].key || (v[i - 1].key == v[i].key && v[i - 1].order > v[i].order)) {
+			stable = false;
+		}
+		if (r[i].key != v[i].key || r[i].order != v[i].order) {
+			stable = false;
+		}
+	}
+	std::cout << stable << " " << v.front().key << " " << v.back().key << std::endl;
+}
+
+void TestThrowingStableSort()
+{
+	std::cout << "Testing stable_sort with a throwing comparator..." << std::endl;
+	sjtu::vector<std::string> v;
+	long long length = 0;
+	for (int i = 0; i < 3000; ++i) {
+		// long enough to live on the heap, so that a lost string is a leak
+		v.push_back(std::string(20 + Rand() % 20, static_cast<char>('a' + Rand() % 26)));
+		length += v.back().size();
+	}
+	int caught = 0;
+	for (int budget = 100; budget < 40000; budget += 3001) {
+		int left = budget;
+		try {
+			sjtu::stable_sort(v, [&left](const std::string &a, const std::string &b) {
+				if (left-- == 0) {
+					throw sjtu::runtime_error();
+				}
+				return a < b;
+			});
+		} catch (const sjtu::runtime_error &) {
+			++caught;
+		}
+		long long now = 0;
+		for (size_t i = 0; i < v.size(); ++i) {
+			now += v[i].size();
+		}
+		if (now != length) {
+			std::cout << "lost elements" << std::endl;
+		}
+	}
+	std::cout << "caught " << caught << ", " << v.size() << " " << IsSorted(v) << std::endl;
+}
+
+void TestRadixKeys()
+{
+	std::cout << "Testing radix_sort keys..." << std::endl;
+	sjtu::vector<double> d;
+	double values[] = {3.5, -0.0, -2.25, 1e300, -1e-300, 0.0, -7.0, 2.0, -1e300, 0.5};
+	for (double x : values) {
+		d.push_back(x);
+	}
+	sjtu::radix_sort(d);
+	for (size_t i = 0; i < d.size(); ++i) {
+		std::cout << d[i] << " ";
+	}
+	std::cout << std::endl;
+	sjtu::vector<long long> l;
+	for (int i = 0; i < 10; ++i) {
+		l.push_back((i % 2 ? -1LL : 1LL) * (1LL << (i * 6)));
+	}
+	sjtu::radix_sort(l);
+	for (size_t i = 0; i < l.size(); ++i) {
+		std::cout << l[i] << " ";
+	}
+	std::cout << std::endl;
+	sjtu::vector<std::string> s;
+	s.push_back("ccc");
+	s.push_back("a");
+	s.push_back("bb");
+	s.push_back("");
+	sjtu::radix_sort(s, [](const std::string &x) { return static_cast<unsigned char>(x.size()); });
+	for (size_t i = 0; i < s.size(); ++i) {
+		std::cout << "[" << s[i] << "]";
+	}
+	std::cout << std::endl;
+}
+
+void TestThrowingRadixKey()
+{
+	std::cout << "Testing radix_sort with a throwing key..." << std::endl;
+	sjtu::vector<std::string> v;
+	for (int i = 0; i < 2000; ++i) {
+		v.push_back(std::string(20 + Rand() % 300, static_cast<char>('a' + Rand() % 26)));
+	}
+	sjtu::vector<std::string> before = v;
+	int caught = 0, unchanged = 0;
+	// the first 2001 calls are made before anything moves
+	for (int budget = 0; budget < 6000; budget += 541) {
+		int left = budget;
+		try {
+			sjtu::radix_sort(v, [&left](const std::string &x) {
+				if (left-- == 0) {
+					throw sjtu::runtime_error();
+				}
+				return static_cast<unsigned short>(x.size());
+			});
+		} catch (const sjtu::runtime_error &) {
+			++caught;
+		}
+		bool same = v.size() == before.size();
+		for (size_t i = 0; i < v.size() && same; ++i) {
+			same = v[i] == before[i];
+		}
+		unchanged += same;
+	}
+	sjtu::radix_sort(v, [](const std::string &x) { return static_cast<unsigned short>(x.size()); });
+	bool sorted = true;
+	for (size_t i = 1; i < v.size(); ++i) {
+		sorted = sorted && v[i - 1].size() <= v[i].size();
+	}
+	std::cout << "caught " << caught << ", unchanged " << unchanged << ", " << v.size() << " " << sorted << std::endl;
+}
+
+int main()
+{
+	TestSort();
+	TestStableSort();
+	TestThrowingStableSort();
+	TestRadixKeys();
+	TestThrowingRadixKey();
+	return 0;
+}
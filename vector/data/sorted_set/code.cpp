@@ -0,0 +1,178 @@
+#include "sorted_set.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+unsigned int last = 233;
+
+unsigned int Rand()
+{
+	return last = last * 1103515245u + 12345u;
+}
+
+// n distinct sorted values drawn from [0, range)
+sjtu::vector<int> MakeSet(int n, int range)
+{
+	std::vector<int> v;
+	for (int i = 0; i < n; ++i) {
+		v.push_back(static_cast<int>(Rand() % range) - range / 2);
+	}
+	std::sort(v.begin(), v.end());
+	v.erase(std::unique(v.begin(), v.end()), v.end());
+	sjtu::vector<int> res;
+	res.assign(v.begin(), v.end());
+	return res;
+}
+
+std::vector<int> ToStd(const sjtu::vector<int> &v)
+{
+	return std::vector<int>(v.data(), v.data() + v.size());
+}
+
+void Print(const sjtu::vector<int> &v)
+{
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << " ";
+	}
+	std::cout << std::endl;
+}
+
+void TestSmall()
+{
+	std::cout << "Testing small sets..." << std::endl;
+	int x[] = {1, 3, 5, 7, 9, 11, 13, 15, 17};
+	int y[] = {2, 3, 4, 5, 6, 15, 16, 17, 18, 19};
+	sjtu::vector<int> a, b, out;
+	a.assign(std::begin(x), std::end(x));
+	b.assign(std::begin(y), std::end(y));
+	sjtu::set_intersection(a, b, out);
+	Print(out);
+	sjtu::set_union(a, b, out);
+	Print(out);
+	sjtu::set_difference(a, b, out);
+	Print(out);
+	sjtu::set_difference(b, a, out);
+	Print(out);
+	sjtu::vector<int> empty;
+	sjtu::set_intersection(a, empty, out);
+	std::cout << out.size() << " ";
+	sjtu::set_union(empty, b, out);
+	std::cout << out.size() << std::endl;
+}
+
+void TestAgainstStd()
+{
+	std::cout << "Testing against std algorithms..." << std::endl;
+	int failures = 0, checks = 0;
+	for (int ratio : {1, 2, 7, 31, 33, 100, 1000}) {
+		for (int n : {3, 4, 17, 64, 500}) {
+			for (int range : {2, 10, 1000}) {
+				sjtu::vector<int> a = MakeSet(n, n * range), b = MakeSet(n * ratio, n * range);
+				for (int swapped = 0; swapped < 2; ++swapped) {
+					std::vector<int> sa = ToStd(a), sb = ToStd(b), expect;
+					sjtu::vector<int> out;
+					std::set_intersection(sa.begin(), sa.end(), sb.begin(), sb.end(), std::back_inserter(expect));
+					sjtu::set_intersection(a, b, out);
+					failures += ToStd(out) != expect;
+					expect.clear();
+					std::set_union(sa.begin(), sa.end(), sb.begin(), sb.end(), std::back_inserter(expect));
+					sjtu::set_union(a, b, out);
+					failures += ToStd(out) != expect;
+					expect.clear();
+					std::set_difference(sa.begin(), sa.end(), sb.begin(), sb.end(), std::back_inserter(expect));
+					sjtu::set_difference(a, b, out);
+					failures += ToStd(out) != expect;
+					checks += 3;
+					a.swap(b);
+				}
+			}
+		}
+	}
+	std::cout << checks << " checks, " << failures << " failures" << std::endl;
+}
+
+void TestUniqueAndMerge()
+{
+	std::cout << "Testing unique and k-way merge..." << std::endl;
+	int x[] = {1, 1, 2, 2, 2, 3, 5, 5, 8};
+	sjtu::vector<int> a, out;
+	a.assign(std::begin(x), std::end(x));
+	sjtu::unique(a, out);
+	Print(out);
+	sjtu::vector<sjtu::vector<int>> lists;
+	for (int i = 0; i < 5; ++i) {
+		sjtu::vector<int> list;
+		for (int j = 0; j < i * 3; ++j) {
+			list.push_back(j * (i + 1) % 17);
+		}
+		std::sort(list.data(), list.data() + list.size());
+		lists.push_back(list);
+	}
+	sjtu::merge(lists, out);
+	Print(out);
+	sjtu::vector<int> dedup;
+	sjtu::unique(out, dedup);
+	Print(dedup);
+}
+
+// copying a Fragile throws once copies copies have been made, if copies is not negative
+struct Fragile {
+	static int copies;
+	int value;
+	Fragile(int v) : value(v) {}
+	Fragile(const Fragile &other) : value(other.value) {
+		if (copies == 0) {
+			throw sjtu::runtime_error();
+		}
+		if (copies > 0) {
+			--copies;
+		}
+	}
+	Fragile(Fragile &&other) noexcept = default;
+	Fragile &operator=(const Fragile &other) = default;
+	bool operator<(const Fragile &rhs) const {
+		return value < rhs.value;
+	}
+};
+int Fragile::copies = -1;
+
+void TestThrowingMerge()
+{
+	std::cout << "Testing k-way merge with a throwing copy..." << std::endl;
+	sjtu::vector<sjtu::vector<Fragile>> lists;
+	for (int i = 0; i < 6; ++i) {
+		sjtu::vector<Fragile> list;
+		for (int j = 0; j < 20; ++j) {
+			list.push_back(Fragile(j * 6 + i));
+		}
+		lists.push_back(list);
+	}
+	sjtu::vector<Fragile> out;
+	int caught = 0;
+	for (int copies = 0; copies < 120; copies += 17) {
+		Fragile::copies = copies;
+		try {
+			sjtu::merge(lists, out);
+		} catch (const sjtu::runtime_error &) {
+			++caught;
+		}
+		Fragile::copies = -1;
+	}
+	sjtu::merge(lists, out);
+	bool sorted = out.size() == 120;
+	for (size_t i = 0; i < out.size() && sorted; ++i) {
+		sorted = out[i].value == static_cast<int>(i);
+	}
+	std::cout << "caught " << caught << ", " << out.size() << " " << sorted << std::endl;
+}
+
+int main()
+{
+	TestSmall();
+	TestAgainstStd();
+	TestUniqueAndMerge();
+	TestThrowingMerge();
+	return 0;
+}
@@ -0,0 +1,87 @@
+#include "span.hpp"
+
+#include <iostream>
+
+long long Sum(sjtu::const_span<int> s)
+{
+	long long sum = 0;
+	for (const int &x : s) {
+		sum += x;
+	}
+	return sum;
+}
+
+void Scale(sjtu::span<int> s, int k)
+{
+	for (size_t i = 0; i < s.size(); ++i) {
+		s[i] *= k;
+	}
+}
+
+void TestViews()
+{
+	std::cout << "Testing views..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 1; i <= 10; ++i) {
+		v.push_back(i);
+	}
+	std::cout << Sum(v) << std::endl;
+	sjtu::span<int> s = v;
+	Scale(s.subspan(2, 3), 10);
+	Scale(s.last(2), -1);
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << " ";
+	}
+	std::cout << std::endl;
+	const sjtu::vector<int> &cv = v;
+	sjtu::const_span<int> cs = cv;
+	std::cout << Sum(cs.first(3)) << " " << Sum(cs.subspan(7)) << " " << cs.front() << " " << cs.back() << std::endl;
+	// batching: consecutive slices of one buffer, no copies
+	for (size_t offset = 0; offset < cs.size(); offset += 4) {
+		size_t count = cs.size() - offset < 4 ? cs.size() - offset : 4;
+		std::cout << Sum(cs.subspan(offset, count)) << " ";
+	}
+	std::cout << std::endl;
+	std::cout << (cs.data() == v.data()) << " " << s.subspan(10).empty() << std::endl;
+	// a pointer with a size, including 0, or a pair of pointers
+	int a[4] = {1, 2, 3, 4};
+	sjtu::span<int> none(a, 0), three(a, 3), pair(a, a + 4);
+	sjtu::const_span<int> from_mutable(a + 1, a + 4);
+	std::cout << none.size() << " " << Sum(three) << " " << Sum(pair) << " " << Sum(from_mutable) << std::endl;
+}
+
+void TestExceptions()
+{
+	std::cout << "Testing exceptions..." << std::endl;
+	sjtu::vector<int> v;
+	v.push_back(1);
+	v.push_back(2);
+	sjtu::span<int> s = v;
+	try {
+		s[2];
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "index_out_of_bound" << std::endl;
+	}
+	try {
+		s.subspan(1, 2);
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "index_out_of_bound" << std::endl;
+	}
+	try {
+		s.first(3);
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "index_out_of_bound" << std::endl;
+	}
+	try {
+		sjtu::span<int>().back();
+	} catch (sjtu::container_is_empty &) {
+		std::cout << "container_is_empty" << std::endl;
+	}
+}
+
+int main()
+{
+	TestViews();
+	TestExceptions();
+	return 0;
+}
@@ -0,0 +1,219 @@
+// append-only vector for many producer threads
+
+#ifndef SJTU_CONCURRENT_VECTOR_HPP
+#define SJTU_CONCURRENT_VECTOR_HPP
+
+#include "exceptions.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+
+namespace sjtu {
+/**
+ * a vector that many threads can push_back into at the same time.
+ * Storage is a list of segments of sizes 8, 16, 32, ..., so an element
+ * never moves once constructed and references stay valid while other
+ * threads keep appending.
+ * push_back and grow_by are lock-free: the segments a slot needs are installed
+ * first, each with one compare-and-swap, and then the slot is claimed with a
+ * compare-and-swap on the size, so an allocation failure claims nothing.
+ * operator[] / at may run concurrently with appends; clear() and the
+ * destructor may not.
+ */
+template<typename T>
+class concurrent_vector {
+public:
+  concurrent_vector() : size_(0) {
+    for (size_t i = 0; i < kSegments; ++i) {
+      segments_[i].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+  concurrent_vector(const concurrent_vector &) = delete;
+  concurrent_vector &operator = (const concurrent_vector &) = delete;
+  ~concurrent_vector() {
+    clear();
+  }
+
+  /**
+   * appends value and returns its index.
+   */
+  size_t push_back(const T &value) {
+    size_t ind = Claim(1);
+    Construct(ind, value);
+    return ind;
+  }
+  /**
+   * appends n copies of value at consecutive indices and returns the first one.
+   * If a copy throws, the slot it was for and all slots after it stay claimed
+   * but broken, so at() throws runtime_error for them instead of waiting.
+   */
+  size_t grow_by(size_t n, const T &value) {
+    size_t first = Claim(n), i = 0;
+    try {
+      for (; i < n; ++i) {
+        Construct(first + i, value);
+      }
+    } catch (...) {
+      // Construct has marked slot i already, nobody will construct the rest
+      for (size_t j = first + i + 1; j < first + n; ++j) {
+        size_t seg = SegmentOf(j);
+        GetSegment(seg)->state_[j - SegmentBegin(seg)].store(kBroken, std::memory_order_release);
+      }
+      throw;
+    }
+    return first;
+  }
+
+  /**
+   * access specified element with bounds checking.
+   * If another thread has claimed pos but is still constructing the element,
+   * waits until it is done.
+   * throw index_out_of_bound if pos is not in [0, size)
+   * throw runtime_error if constructing that element threw
+   */
+  T &at(const size_t &pos) {
+    return const_cast<T &>(static_cast<const concurrent_vector *>(this)->at(pos));
+  }
+  const T &at(const size_t &pos) const {
+    if (pos >= size_.load(std::memory_order_acquire)) {
+      throw index_out_of_bound();
+    }
+    size_t seg = SegmentOf(pos), offset = pos - SegmentBegin(seg);
+    segment *s;
+    while ((s = segments_[seg].load(std::memory_order_acquire)) == nullptr) {
+      std::this_thread::yield();
+    }
+    unsigned char state;
+    while ((state = s->state_[offset].load(std::memory_order_acquire)) == kPending) {
+      std::this_thread::yield();
+    }
+    if (state == kBroken) {
+      throw runtime_error();
+    }
+    return s->values_[offset];
+  }
+  T &operator [] (const size_t &pos) {
+    return at(pos);
+  }
+  const T &operator [] (const size_t &pos) const {
+    return at(pos);
+  }
+
+  /**
+   * returns the number of claimed slots, including ones still under construction.
+   */
+  size_t size() const {
+    return size_.load(std::memory_order_acquire);
+  }
+  bool empty() const {
+    return size() == 0;
+  }
+  /**
+   * destroys all elements and frees all segments. Not thread-safe.
+   */
+  void clear() {
+    size_t size = size_.load(std::memory_order_relaxed);
+    for (size_t seg = 0; seg < kSegments; ++seg) {
+      segment *s = segments_[seg].load(std::memory_order_relaxed);
+      if (s == nullptr) {
+        continue;
+      }
+      size_t begin = SegmentBegin(seg);
+      for (size_t i = 0; i < SegmentSize(seg) && begin + i < size; ++i) {
+        if (s->state_[i].load(std::memory_order_relaxed) == kReady) {
+          s->values_[i].~T();
+        }
+      }
+      FreeSegment(s);
+      segments_[seg].store(nullptr, std::memory_order_relaxed);
+    }
+    size_.store(0, std::memory_order_relaxed);
+  }
+
+private:
+  static constexpr size_t kFirstSegmentBits = 3;
+  static constexpr size_t kSegments = sizeof(size_t) * 8 - kFirstSegmentBits;
+  static constexpr unsigned char kPending = 0, kReady = 1, kBroken = 2;
+  struct segment {
+    T *values_;
+    std::atomic<unsigned char> *state_;
+  };
+  std::atomic<segment *> segments_[kSegments];
+  std::atomic<size_t> size_;
+
+  // segment seg holds indices [8 * (2^seg - 1), 8 * (2^(seg + 1) - 1))
+  static size_t SegmentOf(size_t ind) {
+    size_t x = (ind >> kFirstSegmentBits) + 1, seg = 0;
+    while (x >>= 1) {
+      ++seg;
+    }
+    return seg;
+  }
+  static size_t SegmentBegin(size_t seg) {
+    return ((size_t(1) << seg) - 1) << kFirstSegmentBits;
+  }
+  static size_t SegmentSize(size_t seg) {
+    return size_t(1) << (seg + kFirstSegmentBits);
+  }
+  static void FreeSegment(segment *s) {
+    operator delete [] (s->values_);
+    operator delete [] (s->state_);
+    delete s;
+  }
+  segment *GetSegment(size_t seg) {
+    segment *s = segments_[seg].load(std::memory_order_acquire);
+    if (s != nullptr) {
+      return s;
+    }
+    size_t n = SegmentSize(seg);
+    segment *fresh = new segment{nullptr, nullptr};
+    try {
+      fresh->values_ = static_cast<T *>(operator new [] (n * sizeof(T)));
+      fresh->state_ = static_cast<std::atomic<unsigned char> *>(operator new [] (n * sizeof(std::atomic<unsigned char>)));
+    } catch (...) {
+      FreeSegment(fresh);
+      throw;
+    }
+    for (size_t i = 0; i < n; ++i) {
+      new(&fresh->state_[i]) std::atomic<unsigned char>(kPending);
+    }
+    // another thread may have installed the segment meanwhile, then use theirs
+    if (segments_[seg].compare_exchange_strong(s, fresh, std::memory_order_acq_rel, std::memory_order_acquire)) {
+      return fresh;
+    }
+    FreeSegment(fresh);
+    return s;
+  }
+  /**
+   * claims n consecutive slots and returns the first one.
+   * The segments covering them are allocated before the claim is published,
+   * so if that throws no slot is left that nobody will ever construct.
+   */
+  size_t Claim(size_t n) {
+    size_t first = size_.load(std::memory_order_relaxed);
+    do {
+      if (n > 0) {
+        for (size_t seg = SegmentOf(first), last = SegmentOf(first + n - 1); seg <= last; ++seg) {
+          GetSegment(seg);
+        }
+      }
+    } while (!size_.compare_exchange_weak(first, first + n, std::memory_order_relaxed));
+    return first;
+  }
+  void Construct(size_t ind, const T &value) {
+    size_t seg = SegmentOf(ind), offset = ind - SegmentBegin(seg);
+    segment *s = GetSegment(seg);
+    try {
+      new(&s->values_[offset]) T(value);
+    } catch (...) {
+      s->state_[offset].store(kBroken, std::memory_order_release);
+      throw;
+    }
+    s->state_[offset].store(kReady, std::memory_order_release);
+  }
+};
+
+}
+
+#endif
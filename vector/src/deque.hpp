@@ -0,0 +1,337 @@
+// ring buffer whose capacity is always a power of two
+
+#ifndef SJTU_DEQUE_HPP
+#define SJTU_DEQUE_HPP
+
+#include "exceptions.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+namespace sjtu {
+/**
+ * a double-ended queue like std::deque.
+ * push and pop at both ends are amortized O(1) and random access is O(1).
+ * Elements are stored in a circular buffer, the element with index i lives
+ * in slot (head_ + i) & (capacity_ - 1).
+ * Any push may reallocate and invalidate all iterators and references.
+ */
+template<typename T>
+class deque {
+private:
+  template<typename U>
+  class basic_iterator {
+    friend class deque;
+  public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using pointer = U*;
+    using reference = U&;
+    using iterator_category = std::random_access_iterator_tag;
+
+  private:
+    const deque *container_;
+    size_t ind_;
+  public:
+    basic_iterator() : container_(nullptr), ind_(0) {}
+    basic_iterator(const deque *container, size_t ind) : container_(container), ind_(ind) {}
+    /**
+     * an iterator converts to a const_iterator.
+     */
+    operator basic_iterator<const T> () const {
+      return basic_iterator<const T>(container_, ind_);
+    }
+
+    basic_iterator operator + (const difference_type &n) const {
+      return basic_iterator(container_, ind_ + n);
+    }
+    basic_iterator operator - (const difference_type &n) const {
+      return basic_iterator(container_, ind_ - n);
+    }
+    // throw invalid_iterator if these two iterators point to different deques.
+    difference_type operator - (const basic_iterator &rhs) const {
+      if (container_ != rhs.container_) {
+        throw invalid_iterator();
+      }
+      return static_cast<difference_type>(ind_) - static_cast<difference_type>(rhs.ind_);
+    }
+    basic_iterator &operator += (const difference_type &n) {
+      ind_ += n;
+      return *this;
+    }
+    basic_iterator &operator -= (const difference_type &n) {
+      ind_ -= n;
+      return *this;
+    }
+
+    basic_iterator operator ++ (int) {
+      auto tmp = *this;
+      ++ind_;
+      return tmp;
+    }
+    basic_iterator &operator ++ () {
+      ++ind_;
+      return *this;
+    }
+    basic_iterator operator -- (int) {
+      auto tmp = *this;
+      --ind_;
+      return tmp;
+    }
+    basic_iterator &operator -- () {
+      --ind_;
+      return *this;
+    }
+
+    U &operator * () const {
+      return container_->Slot(ind_);
+    }
+    U *operator -> () const {
+      return &container_->Slot(ind_);
+    }
+    U &operator [] (const difference_type &n) const {
+      return container_->Slot(ind_ + n);
+    }
+
+    bool operator == (const basic_iterator &rhs) const {
+      return container_ == rhs.container_ && ind_ == rhs.ind_;
+    }
+    bool operator != (const basic_iterator &rhs) const {
+      return !(*this == rhs);
+    }
+    bool operator < (const basic_iterator &rhs) const {
+      return *this - rhs < 0;
+    }
+    bool operator > (const basic_iterator &rhs) const {
+      return rhs < *this;
+    }
+    bool operator <= (const basic_iterator &rhs) const {
+      return !(rhs < *this);
+    }
+    bool operator >= (const basic_iterator &rhs) const {
+      return !(*this < rhs);
+    }
+    friend basic_iterator operator + (const difference_type &n, const basic_iterator &it) {
+      return it + n;
+    }
+  };
+
+public:
+  using iterator = basic_iterator<T>;
+  using const_iterator = basic_iterator<const T>;
+
+  deque() : array_(nullptr), capacity_(0), head_(0), size_(0) {}
+  deque(const deque &other) : deque() {
+    if (other.size_ == 0) {
+      return;
+    }
+    array_ = static_cast<T *>(operator new [] (RoundUp(other.size_) * sizeof(T)));
+    capacity_ = RoundUp(other.size_);
+    for (; size_ < other.size_; ++size_) {
+      new(&array_[size_]) T(other.Slot(size_));
+    }
+  }
+  ~deque() {
+    clear();
+    operator delete [] (array_);
+  }
+  deque &operator = (const deque &other) {
+    if (this == &other) {
+      return *this;
+    }
+    deque tmp(other);
+    swap(tmp);
+    return *this;
+  }
+  /**
+   * exchanges the contents with other in O(1).
+   */
+  void swap(deque &other) {
+    std::swap(array_, other.array_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(head_, other.head_);
+    std::swap(size_, other.size_);
+  }
+
+  /**
+   * access specified element with bounds checking.
+   * throw index_out_of_bound if pos is not in [0, size)
+   */
+  T &at(const size_t &pos) {
+    if (pos >= size_) {
+      throw index_out_of_bound();
+    }
+    return Slot(pos);
+  }
+  const T &at(const size_t &pos) const {
+    if (pos >= size_) {
+      throw index_out_of_bound();
+    }
+    return Slot(pos);
+  }
+  T &operator [] (const size_t &pos) {
+    return at(pos);
+  }
+  const T &operator [] (const size_t &pos) const {
+    return at(pos);
+  }
+  /**
+   * access the first element.
+   * throw container_is_empty if size == 0
+   */
+  T &front() {
+    if (size_ == 0) {
+      throw container_is_empty();
+    }
+    return Slot(0);
+  }
+  const T &front() const {
+    if (size_ == 0) {
+      throw container_is_empty();
+    }
+    return Slot(0);
+  }
+  /**
+   * access the last element.
+   * throw container_is_empty if size == 0
+   */
+  T &back() {
+    if (size_ == 0) {
+      throw container_is_empty();
+    }
+    return Slot(size_ - 1);
+  }
+  const T &back() const {
+    if (size_ == 0) {
+      throw container_is_empty();
+    }
+    return Slot(size_ - 1);
+  }
+
+  iterator begin() {
+    return iterator(this, 0);
+  }
+  const_iterator begin() const {
+    return const_iterator(this, 0);
+  }
+  const_iterator cbegin() const {
+    return const_iterator(this, 0);
+  }
+  iterator end() {
+    return iterator(this, size_);
+  }
+  const_iterator end() const {
+    return const_iterator(this, size_);
+  }
+  const_iterator cend() const {
+    return const_iterator(this, size_);
+  }
+
+  bool empty() const {
+    return size_ == 0;
+  }
+  size_t size() const {
+    return size_;
+  }
+  /**
+   * destroys all elements but keeps the buffer.
+   */
+  void clear() {
+    for (size_t i = 0; i < size_; ++i) {
+      Slot(i).~T();
+    }
+    head_ = 0;
+    size_ = 0;
+  }
+  /**
+   * makes room for n elements without reallocating.
+   */
+  void reserve(size_t n) {
+    if (n > capacity_) {
+      Adjust(RoundUp(n));
+    }
+  }
+
+  void push_back(const T &value) {
+    if (size_ == capacity_) {
+      T copy(value); // value may be an element of this deque
+      Adjust(RoundUp(capacity_ * 2));
+      new(&Slot(size_)) T(std::move(copy));
+    } else {
+      new(&Slot(size_)) T(value);
+    }
+    ++size_;
+  }
+  void push_front(const T &value) {
+    if (size_ == capacity_) {
+      T copy(value);
+      Adjust(RoundUp(capacity_ * 2));
+      new(&array_[capacity_ - 1]) T(std::move(copy));
+      head_ = capacity_ - 1;
+    } else {
+      size_t head = (head_ - 1) & (capacity_ - 1);
+      new(&array_[head]) T(value);
+      head_ = head;
+    }
+    ++size_;
+  }
+  /**
+   * throw container_is_empty if size == 0
+   */
+  void pop_back() {
+    if (size_ == 0) {
+      throw container_is_empty();
+    }
+    Slot(--size_).~T();
+  }
+  /**
+   * throw container_is_empty if size == 0
+   */
+  void pop_front() {
+    if (size_ == 0) {
+      throw container_is_empty();
+    }
+    array_[head_].~T();
+    head_ = (head_ + 1) & (capacity_ - 1);
+    --size_;
+  }
+
+private:
+  T *array_;
+  size_t capacity_, head_, size_;
+
+  T &Slot(size_t ind) const {
+    return array_[(head_ + ind) & (capacity_ - 1)];
+  }
+  static size_t RoundUp(size_t n) {
+    size_t capacity = 8;
+    while (capacity < n) {
+      capacity <<= 1;
+    }
+    return capacity;
+  }
+  /**
+   * moves the elements to a new buffer, unwrapped so that head_ == 0.
+   */
+  void Adjust(size_t new_capacity) {
+    T *new_array = static_cast<T *>(operator new [] (new_capacity * sizeof(T)));
+    for (size_t i = 0; i < size_; ++i) {
+      new(&new_array[i]) T(std::move(Slot(i)));
+      Slot(i).~T();
+    }
+    operator delete [] (array_);
+    array_ = new_array;
+    capacity_ = new_capacity;
+    head_ = 0;
+  }
+};
+
+template<typename T>
+void swap(deque<T> &lhs, deque<T> &rhs) {
+  lhs.swap(rhs);
+}
+
+}
+
+#endif
@@ -0,0 +1,433 @@
+// compressed sparse row storage for a sequence of variable-length rows
+
+#ifndef SJTU_JAGGED_VECTOR_HPP
+#define SJTU_JAGGED_VECTOR_HPP
+
+#include "exceptions.hpp"
+#include "span.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace sjtu {
+/**
+ * a replacement of vector<vector<T>>.
+ * All values live in one contiguous buffer and row i occupies
+ * [offsets_[i], offsets_[i + 1]) of it, so adding a row never allocates
+ * on its own and neighbouring rows are neighbours in memory.
+ * Only the last row can grow or shrink.
+ */
+template<typename T>
+class jagged_vector {
+public:
+  /**
+   * views of one row, invalidated by any operation that reallocates the values buffer.
+   */
+  using row = span<T>;
+  using const_row = span<const T>;
+
+  jagged_vector() : values_(nullptr), size_(0), capacity_(0), offsets_(nullptr), rows_(0), row_capacity_(0) {}
+  /**
+   * bulk build: row i has row_sizes[i] copies of value.
+   * Exactly one allocation is made for the values and one for the offsets.
+   */
+  jagged_vector(const vector<size_t> &row_sizes, const T &value) : jagged_vector() {
+    assign(row_sizes, value);
+  }
+  jagged_vector(const jagged_vector &other) : jagged_vector() {
+    if (other.rows_ == 0) {
+      return;
+    }
+    ReserveRows(other.rows_);
+    std::memcpy(offsets_, other.offsets_, (other.rows_ + 1) * sizeof(size_t));
+    ReserveValues(other.size_);
+    for (; size_ < other.size_; ++size_) {
+      new(&values_[size_]) T(other.values_[size_]);
+    }
+    rows_ = other.rows_;
+  }
+  ~jagged_vector() {
+    DestroyValues();
+    operator delete [] (values_);
+    operator delete [] (offsets_);
+  }
+  jagged_vector &operator = (const jagged_vector &other) {
+    if (this == &other) {
+      return *this;
+    }
+    jagged_vector tmp(other);
+    swap(tmp);
+    return *this;
+  }
+  void swap(jagged_vector &other) {
+    std::swap(values_, other.values_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(offsets_, other.offsets_);
+    std::swap(rows_, other.rows_);
+    std::swap(row_capacity_, other.row_capacity_);
+  }
+
+  /**
+   * access row ind.
+   * throw index_out_of_bound if ind is not in [0, rows)
+   */
+  row operator [] (const size_t &ind) {
+    if (ind >= rows_) {
+      throw index_out_of_bound();
+    }
+    return row(values_ + offsets_[ind], offsets_[ind + 1] - offsets_[ind]);
+  }
+  const_row operator [] (const size_t &ind) const {
+    if (ind >= rows_) {
+      throw index_out_of_bound();
+    }
+    return const_row(values_ + offsets_[ind], offsets_[ind + 1] - offsets_[ind]);
+  }
+  /**
+   * access a single value with bounds checking on both coordinates.
+   */
+  T &at(const size_t &ind, const size_t &pos) {
+    return (*this)[ind][pos];
+  }
+  const T &at(const size_t &ind, const size_t &pos) const {
+    return (*this)[ind][pos];
+  }
+  /**
+   * the last row, where push_back appends.
+   * throw container_is_empty if there is no row
+   */
+  row back() {
+    if (rows_ == 0) {
+      throw container_is_empty();
+    }
+    return (*this)[rows_ - 1];
+  }
+  const_row back() const {
+    if (rows_ == 0) {
+      throw container_is_empty();
+    }
+    return (*this)[rows_ - 1];
+  }
+  /**
+   * the whole values buffer, row after row.
+   */
+  T *data() {
+    return values_;
+  }
+  const T *data() const {
+    return values_;
+  }
+  /**
+   * the index in data() where row ind begins, row_begin(rows()) == size().
+   * throw index_out_of_bound if ind is not in [0, rows]
+   */
+  size_t row_begin(const size_t &ind) const {
+    if (ind > rows_) {
+      throw index_out_of_bound();
+    }
+    return ind == 0 ? 0 : offsets_[ind];
+  }
+
+  /**
+   * returns the number of rows
+   */
+  size_t rows() const {
+    return rows_;
+  }
+  /**
+   * returns the number of values in all rows
+   */
+  size_t size() const {
+    return size_;
+  }
+  bool empty() const {
+    return rows_ == 0;
+  }
+  /**
+   * makes room for rows rows holding values values in total without reallocating.
+   */
+  void reserve(size_t rows, size_t values) {
+    ReserveRows(rows);
+    ReserveValues(values);
+  }
+  /**
+   * removes all rows but keeps the buffers.
+   */
+  void clear() {
+    DestroyValues();
+    size_ = 0;
+    rows_ = 0;
+  }
+  /**
+   * replaces the contents by rows of the given sizes filled with value.
+   */
+  void assign(const vector<size_t> &row_sizes, const T &value) {
+    if (&value >= values_ && &value < values_ + size_) {
+      T copy(value); // value is about to be destroyed by clear()
+      assign(row_sizes, copy);
+      return;
+    }
+    clear();
+    size_t total = 0;
+    for (size_t i = 0; i < row_sizes.size(); ++i) {
+      total += row_sizes[i];
+    }
+    reserve(row_sizes.size(), total);
+    for (size_t i = 0; i < row_sizes.size(); ++i) {
+      offsets_[i + 1] = offsets_[i] + row_sizes[i];
+    }
+    for (; size_ < total; ++size_) {
+      new(&values_[size_]) T(value);
+    }
+    rows_ = row_sizes.size();
+  }
+
+  /**
+   * appends an empty row.
+   */
+  void push_row() {
+    ReserveRows(rows_ + 1);
+    offsets_[rows_ + 1] = size_;
+    ++rows_;
+  }
+  /**
+   * appends a row holding [first, last).
+   * If a copy throws, the container is left as it was.
+   */
+  template<typename ForwardIt, typename = decltype(*std::declval<ForwardIt &>())>
+  void push_row(ForwardIt first, ForwardIt last) {
+    size_t count = 0;
+    for (ForwardIt it = first; it != last; ++it) {
+      ++count;
+    }
+    push_row();
+    try {
+      AppendValues(first, count);
+    } catch (...) {
+      --rows_;
+      throw;
+    }
+  }
+  void push_row(const vector<T> &values) {
+    push_row(values.begin(), values.end());
+  }
+  /**
+   * appends a row of count copies of value.
+   * If a copy throws, the container is left as it was.
+   */
+  void push_row(size_t count, const T &value) {
+    push_row();
+    try {
+      AppendValues(RepeatIterator(&value), count);
+    } catch (...) {
+      --rows_;
+      throw;
+    }
+  }
+  /**
+   * adds a value to the end of the last row.
+   * throw container_is_empty if there is no row
+   */
+  void push_back(const T &value) {
+    if (rows_ == 0) {
+      throw container_is_empty();
+    }
+    AppendValues(&value, 1);
+  }
+  /**
+   * removes the last value of the last row.
+   * throw container_is_empty if the last row is empty or there is no row
+   */
+  void pop_back() {
+    if (rows_ == 0 || offsets_[rows_] == offsets_[rows_ - 1]) {
+      throw container_is_empty();
+    }
+    values_[--size_].~T();
+    offsets_[rows_] = size_;
+  }
+  /**
+   * removes the last row.
+   * throw container_is_empty if there is no row
+   */
+  void pop_row() {
+    if (rows_ == 0) {
+      throw container_is_empty();
+    }
+    --rows_;
+    while (size_ > offsets_[rows_]) {
+      values_[--size_].~T();
+    }
+  }
+
+private:
+  T *values_;
+  size_t size_, capacity_;
+  size_t *offsets_; // rows_ + 1 entries, allocated with the first row
+  size_t rows_, row_capacity_;
+
+  void DestroyValues() {
+    for (size_t i = 0; i < size_; ++i) {
+      values_[i].~T();
+    }
+  }
+  void ReserveValues(size_t new_capacity) {
+    if (new_capacity <= capacity_) {
+      return;
+    }
+    T *new_values = static_cast<T *>(operator new [] (new_capacity * sizeof(T)));
+    for (size_t i = 0; i < size_; ++i) {
+      new(&new_values[i]) T(std::move(values_[i]));
+      values_[i].~T();
+    }
+    operator delete [] (values_);
+    values_ = new_values;
+    capacity_ = new_capacity;
+  }
+  /**
+   * copies count values starting at first to the end of the last row. The values may
+   * live in this container: when the buffer has to grow, they are copied into the new
+   * one before the old one is freed, as in vector::GrowAndInsert.
+   * If a copy throws, the container is left as it was.
+   */
+  template<typename ForwardIt>
+  void AppendValues(ForwardIt first, size_t count) {
+    size_t built = 0;
+    if (size_ + count <= capacity_) {
+      try {
+        for (; built < count; ++built, ++first) {
+          new(&values_[size_ + built]) T(*first);
+        }
+      } catch (...) {
+        while (built > 0) {
+          values_[size_ + --built].~T();
+        }
+        throw;
+      }
+    } else {
+      size_t new_capacity = size_ + count < capacity_ * 2 ? capacity_ * 2 : size_ + count;
+      T *new_values = static_cast<T *>(operator new [] (new_capacity * sizeof(T)));
+      try {
+        for (; built < count; ++built, ++first) {
+          new(&new_values[size_ + built]) T(*first);
+        }
+      } catch (...) {
+        while (built > 0) {
+          new_values[size_ + --built].~T();
+        }
+        operator delete [] (new_values);
+        throw;
+      }
+      for (size_t i = 0; i < size_; ++i) {
+        new(&new_values[i]) T(std::move(values_[i]));
+        values_[i].~T();
+      }
+      operator delete [] (values_);
+      values_ = new_values;
+      capacity_ = new_capacity;
+    }
+    size_ += count;
+    offsets_[rows_] = size_;
+  }
+  // yields the same value forever, used by push_row(count, value)
+  class RepeatIterator {
+  private:
+    const T *value_;
+  public:
+    explicit RepeatIterator(const T *value) : value_(value) {}
+    const T &operator * () const {
+      return *value_;
+    }
+    RepeatIterator &operator ++ () {
+      return *this;
+    }
+  };
+  void ReserveRows(size_t new_capacity) {
+    if (new_capacity <= row_capacity_) {
+      return;
+    }
+    if (new_capacity < row_capacity_ * 2) {
+      new_capacity = row_capacity_ * 2;
+    }
+    size_t *new_offsets = static_cast<size_t *>(operator new [] ((new_capacity + 1) * sizeof(size_t)));
+    if (offsets_ == nullptr) {
+      new_offsets[0] = 0;
+    } else {
+      std::memcpy(new_offsets, offsets_, (rows_ + 1) * sizeof(size_t));
+    }
+    operator delete [] (offsets_);
+    offsets_ = new_offsets;
+    row_capacity_ = new_capacity;
+  }
+};
+
+/**
+ * a string table: every string is a row of chars followed by a '\0'
+ * that is not counted in its length, so c_str() needs no copy.
+ */
+template<>
+class jagged_vector<std::string> {
+public:
+  jagged_vector() = default;
+
+  /**
+   * access string ind.
+   * throw index_out_of_bound if ind is not in [0, size)
+   */
+  std::string_view operator [] (const size_t &ind) const {
+    jagged_vector<char>::const_row r = chars_[ind];
+    return std::string_view(r.data(), r.size() - 1);
+  }
+  const char *c_str(const size_t &ind) const {
+    return chars_[ind].data();
+  }
+  size_t length(const size_t &ind) const {
+    return chars_[ind].size() - 1;
+  }
+  /**
+   * returns the number of strings
+   */
+  size_t size() const {
+    return chars_.rows();
+  }
+  bool empty() const {
+    return chars_.empty();
+  }
+  void reserve(size_t strings, size_t chars) {
+    chars_.reserve(strings, chars + strings);
+  }
+  void clear() {
+    chars_.clear();
+  }
+  void push_back(std::string_view str) {
+    chars_.push_row(str.begin(), str.end());
+    try {
+      chars_.push_back('\0');
+    } catch (...) {
+      chars_.pop_row();
+      throw;
+    }
+  }
+  void pop_back() {
+    chars_.pop_row();
+  }
+  void swap(jagged_vector &other) {
+    chars_.swap(other.chars_);
+  }
+
+private:
+  jagged_vector<char> chars_;
+};
+
+template<typename T>
+void swap(jagged_vector<T> &lhs, jagged_vector<T> &rhs) {
+  lhs.swap(rhs);
+}
+
+}
+
+#endif
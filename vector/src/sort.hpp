@@ -0,0 +1,576 @@
+// Sorting for contiguous storage.
+// Reference : Orson Peters, "Pattern-defeating Quicksort", https://arxiv.org/abs/2106.05123
+//             Edelkamp and Weiss, "BlockQuicksort: How Branch Mispredictions don't affect Quicksort"
+
+#ifndef SJTU_SORT_HPP
+#define SJTU_SORT_HPP
+
+#include "vector.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace sjtu {
+
+namespace detail {
+
+constexpr std::ptrdiff_t kInsertionSortThreshold = 24;
+constexpr std::ptrdiff_t kNintherThreshold = 128;
+constexpr std::ptrdiff_t kPartialInsertionSortLimit = 8;
+constexpr std::ptrdiff_t kBlockSize = 64;
+constexpr std::ptrdiff_t kStableRunSize = 32;
+
+/**
+ * Branchless partitioning pays off only when a comparison is a single
+ * cheap instruction, i.e. the default comparators on arithmetic types.
+ */
+template<typename T, class Compare>
+constexpr bool kUseBranchless = std::is_arithmetic_v<T> &&
+    (std::is_same_v<Compare, std::less<T>> || std::is_same_v<Compare, std::greater<T>> ||
+     std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::greater<>>);
+
+/**
+ * The element taken out of the array while sifting. It is moved back into
+ * *pos when the sift ends, also when comp throws, so no element is lost.
+ */
+template<typename T>
+struct Hole {
+  T tmp;
+  T *&pos;
+  ~Hole() {
+    *pos = std::move(tmp);
+  }
+};
+
+template<typename T, class Compare>
+void InsertionSort(T *begin, T *end, Compare &comp) {
+  if (begin == end) {
+    return;
+  }
+  for (T *cur = begin + 1; cur != end; ++cur) {
+    T *sift = cur, *sift_1 = cur - 1;
+    if (comp(*sift, *sift_1)) {
+      Hole<T> hole{T(std::move(*sift)), sift};
+      do {
+        *sift-- = std::move(*sift_1);
+      } while (sift != begin && comp(hole.tmp, *--sift_1));
+    }
+  }
+}
+
+/**
+ * Requires *(begin - 1) to be no greater than any element in [begin, end).
+ */
+template<typename T, class Compare>
+void UnguardedInsertionSort(T *begin, T *end, Compare &comp) {
+  if (begin == end) {
+    return;
+  }
+  for (T *cur = begin + 1; cur != end; ++cur) {
+    T *sift = cur, *sift_1 = cur - 1;
+    if (comp(*sift, *sift_1)) {
+      Hole<T> hole{T(std::move(*sift)), sift};
+      do {
+        *sift-- = std::move(*sift_1);
+      } while (comp(hole.tmp, *--sift_1));
+    }
+  }
+}
+
+/**
+ * Insertion sort that gives up after kPartialInsertionSortLimit moves.
+ * Returns true if [begin, end) ends up sorted.
+ */
+template<typename T, class Compare>
+bool PartialInsertionSort(T *begin, T *end, Compare &comp) {
+  if (begin == end) {
+    return true;
+  }
+  std::ptrdiff_t limit = 0;
+  for (T *cur = begin + 1; cur != end; ++cur) {
+    T *sift = cur, *sift_1 = cur - 1;
+    if (comp(*sift, *sift_1)) {
+      Hole<T> hole{T(std::move(*sift)), sift};
+      do {
+        *sift-- = std::move(*sift_1);
+      } while (sift != begin && comp(hole.tmp, *--sift_1));
+      limit += cur - sift;
+    }
+    if (limit > kPartialInsertionSortLimit) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template<typename T, class Compare>
+void Sort2(T *a, T *b, Compare &comp) {
+  if (comp(*b, *a)) {
+    std::swap(*a, *b);
+  }
+}
+
+template<typename T, class Compare>
+void Sort3(T *a, T *b, T *c, Compare &comp) {
+  Sort2(a, b, comp);
+  Sort2(b, c, comp);
+  Sort2(a, b, comp);
+}
+
+template<typename T, class Compare>
+void SiftDown(T *begin, std::ptrdiff_t size, std::ptrdiff_t pos, Compare &comp) {
+  T tmp(std::move(begin[pos]));
+  while (pos * 2 + 1 < size) {
+    std::ptrdiff_t child = pos * 2 + 1;
+    if (child + 1 < size && comp(begin[child], begin[child + 1])) {
+      ++child;
+    }
+    if (!comp(tmp, begin[child])) {
+      break;
+    }
+    begin[pos] = std::move(begin[child]);
+    pos = child;
+  }
+  begin[pos] = std::move(tmp);
+}
+
+/**
+ * O(n log n) fallback once too many bad partitions were seen.
+ */
+template<typename T, class Compare>
+void HeapSort(T *begin, T *end, Compare &comp) {
+  std::ptrdiff_t size = end - begin;
+  for (std::ptrdiff_t i = size / 2 - 1; i >= 0; --i) {
+    SiftDown(begin, size, i, comp);
+  }
+  for (std::ptrdiff_t i = size - 1; i > 0; --i) {
+    std::swap(begin[0], begin[i]);
+    SiftDown(begin, i, 0, comp);
+  }
+}
+
+/**
+ * Partitions [begin, end) around the pivot *begin, elements equal to the
+ * pivot go to the right. Returns the pivot position and whether no swap was needed.
+ */
+template<typename T, class Compare>
+std::pair<T *, bool> PartitionRight(T *begin, T *end, Compare &comp) {
+  T pivot(std::move(*begin));
+  T *first = begin, *last = end;
+  // The median of 3 guarantees these loops stop.
+  while (comp(*++first, pivot));
+  if (first - 1 == begin) {
+    while (first < last && !comp(*--last, pivot));
+  } else {
+    while (!comp(*--last, pivot));
+  }
+  bool already_partitioned = first >= last;
+  while (first < last) {
+    std::swap(*first, *last);
+    while (comp(*++first, pivot));
+    while (!comp(*--last, pivot));
+  }
+  T *pivot_pos = first - 1;
+  *begin = std::move(*pivot_pos);
+  *pivot_pos = std::move(pivot);
+  return std::pair<T *, bool>(pivot_pos, already_partitioned);
+}
+
+template<typename T>
+void SwapOffsets(T *first, T *last, unsigned char *offsets_l, unsigned char *offsets_r,
+                 std::ptrdiff_t num, bool use_swaps) {
+  if (use_swaps) {
+    // needed for descending inputs to stay O(n)
+    for (std::ptrdiff_t i = 0; i < num; ++i) {
+      std::swap(first[offsets_l[i]], *(last - offsets_r[i]));
+    }
+  } else if (num > 0) {
+    // one cyclic permutation instead of num swaps
+    T *l = first + offsets_l[0], *r = last - offsets_r[0];
+    T tmp(std::move(*l));
+    *l = std::move(*r);
+    for (std::ptrdiff_t i = 1; i < num; ++i) {
+      l = first + offsets_l[i];
+      *r = std::move(*l);
+      r = last - offsets_r[i];
+      *l = std::move(*r);
+    }
+    *r = std::move(tmp);
+  }
+}
+
+/**
+ * Same contract as PartitionRight, but the misplaced elements are found
+ * block by block into offset buffers, so the comparisons do not feed branches.
+ */
+template<typename T, class Compare>
+std::pair<T *, bool> PartitionRightBranchless(T *begin, T *end, Compare &comp) {
+  T pivot(std::move(*begin));
+  T *first = begin, *last = end;
+  while (comp(*++first, pivot));
+  if (first - 1 == begin) {
+    while (first < last && !comp(*--last, pivot));
+  } else {
+    while (!comp(*--last, pivot));
+  }
+  bool already_partitioned = first >= last;
+  if (!already_partitioned) {
+    std::swap(*first, *last);
+    ++first;
+    alignas(64) unsigned char offsets_l[kBlockSize];
+    alignas(64) unsigned char offsets_r[kBlockSize];
+    T *offsets_l_base = first, *offsets_r_base = last;
+    std::ptrdiff_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+    while (first < last) {
+      std::ptrdiff_t num_unknown = last - first;
+      std::ptrdiff_t left_split = num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+      std::ptrdiff_t right_split = num_r == 0 ? (num_unknown - left_split) : 0;
+      if (left_split > kBlockSize) {
+        left_split = kBlockSize;
+      }
+      if (right_split > kBlockSize) {
+        right_split = kBlockSize;
+      }
+      for (std::ptrdiff_t i = 0; i < left_split; ++i) {
+        offsets_l[num_l] = static_cast<unsigned char>(i);
+        num_l += !comp(*first, pivot);
+        ++first;
+      }
+      for (std::ptrdiff_t i = 0; i < right_split;) {
+        offsets_r[num_r] = static_cast<unsigned char>(++i);
+        num_r += comp(*--last, pivot);
+      }
+      std::ptrdiff_t num = num_l < num_r ? num_l : num_r;
+      SwapOffsets(offsets_l_base, offsets_r_base, offsets_l + start_l, offsets_r + start_r,
+                  num, num_l == num_r);
+      num_l -= num;
+      num_r -= num;
+      start_l += num;
+      start_r += num;
+      if (num_l == 0) {
+        start_l = 0;
+        offsets_l_base = first;
+      }
+      if (num_r == 0) {
+        start_r = 0;
+        offsets_r_base = last;
+      }
+    }
+    // Only one side can have leftovers, move them next to the boundary.
+    if (num_l) {
+      while (num_l--) {
+        std::swap(offsets_l_base[offsets_l[start_l + num_l]], *--last);
+      }
+      first = last;
+    }
+    if (num_r) {
+      while (num_r--) {
+        std::swap(*(offsets_r_base - offsets_r[start_r + num_r]), *first);
+        ++first;
+      }
+      last = first;
+    }
+  }
+  T *pivot_pos = first - 1;
+  *begin = std::move(*pivot_pos);
+  *pivot_pos = std::move(pivot);
+  return std::pair<T *, bool>(pivot_pos, already_partitioned);
+}
+
+/**
+ * Partitions with elements equal to the pivot on the left. Used when the
+ * pivot equals the element before the range, so the whole left part
+ * consists of equal elements and needs no further sorting.
+ */
+template<typename T, class Compare>
+T *PartitionLeft(T *begin, T *end, Compare &comp) {
+  T pivot(std::move(*begin));
+  T *first = begin, *last = end;
+  while (comp(pivot, *--last));
+  if (last + 1 == end) {
+    while (first < last && !comp(pivot, *++first));
+  } else {
+    while (!comp(pivot, *++first));
+  }
+  while (first < last) {
+    std::swap(*first, *last);
+    while (comp(pivot, *--last));
+    while (!comp(pivot, *++first));
+  }
+  T *pivot_pos = last;
+  *begin = std::move(*pivot_pos);
+  *pivot_pos = std::move(pivot);
+  return pivot_pos;
+}
+
+template<bool Branchless, typename T, class Compare>
+void PdqSortLoop(T *begin, T *end, Compare &comp, int bad_allowed, bool leftmost) {
+  while (true) {
+    std::ptrdiff_t size = end - begin;
+    if (size < kInsertionSortThreshold) {
+      if (leftmost) {
+        InsertionSort(begin, end, comp);
+      } else {
+        UnguardedInsertionSort(begin, end, comp);
+      }
+      return;
+    }
+    // pivot: median of 3, or pseudo-median of 9 for large ranges
+    std::ptrdiff_t s2 = size / 2;
+    if (size > kNintherThreshold) {
+      Sort3(begin, begin + s2, end - 1, comp);
+      Sort3(begin + 1, begin + (s2 - 1), end - 2, comp);
+      Sort3(begin + 2, begin + (s2 + 1), end - 3, comp);
+      Sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), comp);
+      std::swap(*begin, *(begin + s2));
+    } else {
+      Sort3(begin + s2, begin, end - 1, comp);
+    }
+    // many equal elements: put them all on the left at once
+    if (!leftmost && !comp(*(begin - 1), *begin)) {
+      begin = PartitionLeft(begin, end, comp) + 1;
+      continue;
+    }
+    std::pair<T *, bool> part = Branchless ? PartitionRightBranchless(begin, end, comp)
+                                      : PartitionRight(begin, end, comp);
+    T *pivot_pos = part.first;
+    std::ptrdiff_t l_size = pivot_pos - begin;
+    std::ptrdiff_t r_size = end - (pivot_pos + 1);
+    if (l_size < size / 8 || r_size < size / 8) {
+      if (--bad_allowed == 0) {
+        HeapSort(begin, end, comp);
+        return;
+      }
+      // break patterns that fooled the pivot selection
+      if (l_size >= kInsertionSortThreshold) {
+        std::swap(*begin, *(begin + l_size / 4));
+        std::swap(*(pivot_pos - 1), *(pivot_pos - l_size / 4));
+        if (l_size > kNintherThreshold) {
+          std::swap(*(begin + 1), *(begin + (l_size / 4 + 1)));
+          std::swap(*(begin + 2), *(begin + (l_size / 4 + 2)));
+          std::swap(*(pivot_pos - 2), *(pivot_pos - (l_size / 4 + 1)));
+          std::swap(*(pivot_pos - 3), *(pivot_pos - (l_size / 4 + 2)));
+        }
+      }
+      if (r_size >= kInsertionSortThreshold) {
+        std::swap(*(pivot_pos + 1), *(pivot_pos + (1 + r_size / 4)));
+        std::swap(*(end - 1), *(end - r_size / 4));
+        if (r_size > kNintherThreshold) {
+          std::swap(*(pivot_pos + 2), *(pivot_pos + (2 + r_size / 4)));
+          std::swap(*(pivot_pos + 3), *(pivot_pos + (3 + r_size / 4)));
+          std::swap(*(end - 2), *(end - (1 + r_size / 4)));
+          std::swap(*(end - 3), *(end - (2 + r_size / 4)));
+        }
+      }
+    } else if (part.second && PartialInsertionSort(begin, pivot_pos, comp) &&
+               PartialInsertionSort(pivot_pos + 1, end, comp)) {
+      // the input was (nearly) sorted already
+      return;
+    }
+    // recurse into the left part, loop on the right part
+    PdqSortLoop<Branchless>(begin, pivot_pos, comp, bad_allowed, leftmost);
+    begin = pivot_pos + 1;
+    leftmost = false;
+  }
+}
+
+/**
+ * Merges [first, mid) and [mid, last) using buffer, which is raw storage
+ * for at least mid - first elements.
+ * If comp throws, the elements still in the buffer are moved back into the gap
+ * the merge left in [first, last), so no element is lost, and the buffer is emptied.
+ */
+template<typename T, class Compare>
+void MergeWithBuffer(T *first, T *mid, T *last, T *buffer, Compare &comp) {
+  std::ptrdiff_t n = mid - first;
+  for (std::ptrdiff_t i = 0; i < n; ++i) {
+    new(&buffer[i]) T(std::move(first[i]));
+  }
+  // moves the rest of the left run into place and destroys the buffer, on either way out
+  struct guard {
+    T *&left, *left_end, *&out, *buffer;
+    std::ptrdiff_t n;
+    ~guard() {
+      while (left != left_end) {
+        *out++ = std::move(*left++);
+      }
+      for (std::ptrdiff_t i = 0; i < n; ++i) {
+        buffer[i].~T();
+      }
+    }
+  };
+  T *left = buffer, *right = mid, *out = first;
+  guard g{left, buffer + n, out, buffer, n};
+  while (left != g.left_end && right != last) {
+    if (comp(*right, *left)) {
+      *out++ = std::move(*right++);
+    } else {
+      *out++ = std::move(*left++);
+    }
+  }
+}
+
+template<typename T, class Compare>
+void MergeSort(T *first, T *last, T *buffer, Compare &comp) {
+  if (last - first <= kStableRunSize) {
+    InsertionSort(first, last, comp);
+    return;
+  }
+  T *mid = first + (last - first) / 2;
+  MergeSort(first, mid, buffer, comp);
+  MergeSort(mid, last, buffer, comp);
+  if (comp(*mid, *(mid - 1))) {
+    MergeWithBuffer(first, mid, last, buffer, comp);
+  }
+}
+
+/**
+ * Maps a key to an unsigned integer of the same width whose unsigned order
+ * is the key order.
+ */
+template<typename K>
+auto RadixKey(const K &key) {
+  if constexpr (std::is_floating_point_v<K>) {
+    static_assert(sizeof(K) == 4 || sizeof(K) == 8, "unsupported floating point type");
+    using U = std::conditional_t<sizeof(K) == 4, std::uint32_t, std::uint64_t>;
+    U bits;
+    std::memcpy(&bits, &key, sizeof(K));
+    // negative numbers: reverse their order; positive numbers: put above all negatives
+    return (bits >> (sizeof(U) * 8 - 1)) ? static_cast<U>(~bits)
+                                         : static_cast<U>(bits | (U(1) << (sizeof(U) * 8 - 1)));
+  } else {
+    static_assert(std::is_integral_v<K>, "radix_sort needs an integral or floating point key");
+    using U = std::make_unsigned_t<K>;
+    if constexpr (std::is_signed_v<K>) {
+      return static_cast<U>(static_cast<U>(key) ^ (U(1) << (sizeof(U) * 8 - 1)));
+    } else {
+      return static_cast<U>(key);
+    }
+  }
+}
+
+}
+
+/**
+ * sorts [first, last) with pattern-defeating quicksort, not stable.
+ * O(n log n) in the worst case, O(n) on sorted, reversed and few-distinct inputs.
+ */
+template<typename T, class Compare = std::less<T>>
+void sort(T *first, T *last, Compare comp = Compare()) {
+  if (last - first < 2) {
+    return;
+  }
+  int log2 = 0;
+  for (std::ptrdiff_t n = last - first; n > 1; n >>= 1) {
+    ++log2;
+  }
+  detail::PdqSortLoop<detail::kUseBranchless<T, Compare>>(first, last, comp, log2, true);
+}
+template<typename T, class Compare = std::less<T>>
+void sort(vector<T> &v, Compare comp = Compare()) {
+  sort(v.data(), v.data() + v.size(), comp);
+}
+
+/**
+ * sorts [first, last) keeping the order of equal elements.
+ * Merge sort with insertion-sorted runs, using one buffer of half the size.
+ */
+template<typename T, class Compare = std::less<T>>
+void stable_sort(T *first, T *last, Compare comp = Compare()) {
+  if (last - first < 2) {
+    return;
+  }
+  T *buffer = static_cast<T *>(operator new [] ((last - first + 1) / 2 * sizeof(T)));
+  try {
+    detail::MergeSort(first, last, buffer, comp);
+  } catch (...) {
+    operator delete [] (buffer);
+    throw;
+  }
+  operator delete [] (buffer);
+}
+template<typename T, class Compare = std::less<T>>
+void stable_sort(vector<T> &v, Compare comp = Compare()) {
+  stable_sort(v.data(), v.data() + v.size(), comp);
+}
+
+/**
+ * LSD radix sort on key(element), which must be an integral or floating point value.
+ * Stable, O(n * sizeof(key)) with one byte per pass; passes in which all
+ * keys share the same byte are skipped.
+ * key is called once per element, before anything moves, and the keys travel with
+ * the elements through the passes; so if key throws, [first, last) is left as it was.
+ * Moving T must not throw.
+ */
+template<typename T, class KeyFn>
+void radix_sort(T *first, T *last, KeyFn key) {
+  static_assert(std::is_nothrow_move_constructible_v<T>,
+                "radix_sort moves the elements between two buffers, which must not throw");
+  using U = decltype(detail::RadixKey(key(*first)));
+  constexpr size_t kPasses = sizeof(U);
+  size_t n = last - first;
+  if (n < 2) {
+    return;
+  }
+  // the keys of the elements in from, then room for the keys of those in to
+  vector<U> keys(2 * n, U(0));
+  size_t count[kPasses][256];
+  std::memset(count, 0, sizeof(count));
+  for (size_t i = 0; i < n; ++i) {
+    U k = keys[i] = detail::RadixKey(key(first[i]));
+    for (size_t pass = 0; pass < kPasses; ++pass) {
+      ++count[pass][(k >> (pass * 8)) & 255];
+    }
+  }
+  U first_key = keys[0];
+  T *buffer = static_cast<T *>(operator new [] (n * sizeof(T)));
+  T *from = first, *to = buffer;
+  U *key_from = keys.data(), *key_to = keys.data() + n;
+  for (size_t pass = 0; pass < kPasses; ++pass) {
+    size_t *bucket = count[pass];
+    if (bucket[(first_key >> (pass * 8)) & 255] == n) {
+      continue;
+    }
+    size_t sum = 0;
+    for (size_t b = 0; b < 256; ++b) {
+      size_t c = bucket[b];
+      bucket[b] = sum;
+      sum += c;
+    }
+    for (size_t i = 0; i < n; ++i) {
+      size_t j = bucket[(key_from[i] >> (pass * 8)) & 255]++;
+      key_to[j] = key_from[i];
+      new(&to[j]) T(std::move(from[i]));
+      from[i].~T();
+    }
+    std::swap(from, to);
+    std::swap(key_from, key_to);
+  }
+  if (from != first) {
+    for (size_t i = 0; i < n; ++i) {
+      new(&first[i]) T(std::move(from[i]));
+      from[i].~T();
+    }
+  }
+  operator delete [] (buffer);
+}
+template<typename T>
+void radix_sort(T *first, T *last) {
+  radix_sort(first, last, [](const T &x) { return x; });
+}
+template<typename T, class KeyFn>
+void radix_sort(vector<T> &v, KeyFn key) {
+  radix_sort(v.data(), v.data() + v.size(), key);
+}
+template<typename T>
+void radix_sort(vector<T> &v) {
+  radix_sort(v.data(), v.data() + v.size());
+}
+
+}
+
+#endif
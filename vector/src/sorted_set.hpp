@@ -0,0 +1,369 @@
+// Set operations on sorted, duplicate-free vectors.
+// Reference : Lemire, Boytsov and Kurz, "SIMD Compression and the Intersection of Sorted Integers"
+
+#ifndef SJTU_SORTED_SET_HPP
+#define SJTU_SORTED_SET_HPP
+
+#include "vector.hpp"
+
+#include <cstddef>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace sjtu {
+
+namespace detail {
+
+/**
+ * When one input is this many times longer than the other, the shorter one
+ * is walked element by element and galloping search skips through the longer one.
+ */
+constexpr size_t kGallopRatio = 32;
+
+/**
+ * Returns the first position in [first, last) whose value is not less than value,
+ * probing 1, 2, 4, ... elements ahead before the binary search, so the cost is
+ * O(log d) where d is the distance to the answer.
+ */
+template<typename T>
+const T *Gallop(const T *first, const T *last, const T &value) {
+  size_t step = 1;
+  const T *low = first;
+  while (low + step < last && low[step] < value) {
+    low += step;
+    step <<= 1;
+  }
+  const T *high = low + step < last ? low + step + 1 : last;
+  while (low < high) {
+    const T *mid = low + (high - low) / 2;
+    if (*mid < value) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+template<typename T>
+constexpr bool kUseSimd =
+#if defined(__SSE2__)
+    std::is_integral_v<T> && sizeof(T) == 4;
+#else
+    false;
+#endif
+
+#if defined(__SSE2__)
+/**
+ * Bit k of the result is set if a[k] equals one of b[0..3].
+ * Both blocks are compared in all four rotations of b.
+ */
+template<typename T>
+int BlockMatch(const T *a, const T *b) {
+  __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a));
+  __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b));
+  __m128i m = _mm_cmpeq_epi32(va, vb);
+  m = _mm_or_si128(m, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+  m = _mm_or_si128(m, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+  m = _mm_or_si128(m, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+  return _mm_movemask_ps(_mm_castsi128_ps(m));
+}
+#endif
+
+template<typename T>
+void IntersectGallop(const T *small, const T *small_end, const T *large, const T *large_end, vector<T> &out) {
+  for (; small != small_end && large != large_end; ++small) {
+    large = Gallop(large, large_end, *small);
+    if (large != large_end && !(*small < *large)) {
+      out.push_back(*small);
+      ++large;
+    }
+  }
+}
+
+template<typename T>
+void IntersectMerge(const T *a, const T *a_end, const T *b, const T *b_end, vector<T> &out) {
+#if defined(__SSE2__)
+  if constexpr (kUseSimd<T>) {
+    while (a + 4 <= a_end && b + 4 <= b_end) {
+      int mask = BlockMatch(a, b);
+      for (int k = 0; mask != 0; ++k, mask >>= 1) {
+        if (mask & 1) {
+          out.push_back(a[k]);
+        }
+      }
+      T a_max = a[3], b_max = b[3];
+      a += (a_max <= b_max) * 4;
+      b += (b_max <= a_max) * 4;
+    }
+  }
+#endif
+  while (a != a_end && b != b_end) {
+    T x = *a, y = *b;
+    if (!(x < y) && !(y < x)) {
+      out.push_back(x);
+    }
+    a += !(y < x);
+    b += !(x < y);
+  }
+}
+
+template<typename T>
+void DifferenceGallopLarge(const T *a, const T *a_end, const T *b, const T *b_end, vector<T> &out) {
+  // a is the large side: copy the runs of a between the elements of b
+  for (; b != b_end && a != a_end; ++b) {
+    const T *pos = Gallop(a, a_end, *b);
+    for (; a != pos; ++a) {
+      out.push_back(*a);
+    }
+    if (a != a_end && !(*b < *a)) {
+      ++a;
+    }
+  }
+  for (; a != a_end; ++a) {
+    out.push_back(*a);
+  }
+}
+
+template<typename T>
+void DifferenceGallopSmall(const T *a, const T *a_end, const T *b, const T *b_end, vector<T> &out) {
+  // a is the small side: look every element up in b
+  for (; a != a_end; ++a) {
+    b = Gallop(b, b_end, *a);
+    if (b == b_end || *a < *b) {
+      out.push_back(*a);
+    }
+  }
+}
+
+template<typename T>
+void DifferenceMerge(const T *a, const T *a_end, const T *b, const T *b_end, vector<T> &out) {
+#if defined(__SSE2__)
+  if constexpr (kUseSimd<T>) {
+    int found = 0; // elements of the current block of a seen in earlier blocks of b
+    while (a + 4 <= a_end && b + 4 <= b_end) {
+      found |= BlockMatch(a, b);
+      T a_max = a[3], b_max = b[3];
+      if (a_max <= b_max) {
+        for (int k = 0; k < 4; ++k) {
+          if (!(found >> k & 1)) {
+            out.push_back(a[k]);
+          }
+        }
+        found = 0;
+        a += 4;
+      }
+      b += (b_max <= a_max) * 4;
+    }
+    // finish the block that may have been matched partially
+    if (found != 0) {
+      for (int k = 0; k < 4; ++k, ++a) {
+        if (found >> k & 1) {
+          continue;
+        }
+        while (b != b_end && *b < *a) {
+          ++b;
+        }
+        if (b == b_end || *a < *b) {
+          out.push_back(*a);
+        }
+      }
+    }
+  }
+#endif
+  while (a != a_end && b != b_end) {
+    T x = *a, y = *b;
+    if (x < y) {
+      out.push_back(x);
+    }
+    a += !(y < x);
+    b += !(x < y);
+  }
+  for (; a != a_end; ++a) {
+    out.push_back(*a);
+  }
+}
+
+template<typename T>
+void UnionGallop(const T *small, const T *small_end, const T *large, const T *large_end, vector<T> &out) {
+  for (; small != small_end; ++small) {
+    const T *pos = Gallop(large, large_end, *small);
+    for (; large != pos; ++large) {
+      out.push_back(*large);
+    }
+    out.push_back(*small);
+    if (large != large_end && !(*small < *large)) {
+      ++large;
+    }
+  }
+  for (; large != large_end; ++large) {
+    out.push_back(*large);
+  }
+}
+
+template<typename T>
+void UnionMerge(const T *a, const T *a_end, const T *b, const T *b_end, vector<T> &out) {
+  while (a != a_end && b != b_end) {
+    T x = *a, y = *b;
+    out.push_back(y < x ? y : x);
+    a += !(y < x);
+    b += !(x < y);
+  }
+  for (; a != a_end; ++a) {
+    out.push_back(*a);
+  }
+  for (; b != b_end; ++b) {
+    out.push_back(*b);
+  }
+}
+
+}
+
+/**
+ * The inputs of the functions below must be sorted in increasing order
+ * (by operator <) and contain no duplicates; unique() produces such input.
+ * The result replaces the contents of out, which must not be one of the inputs.
+ */
+
+/**
+ * out = a ∩ b.
+ */
+template<typename T>
+void set_intersection(const vector<T> &a, const vector<T> &b, vector<T> &out) {
+  const vector<T> &small = a.size() <= b.size() ? a : b;
+  const vector<T> &large = a.size() <= b.size() ? b : a;
+  out.clear();
+  out.reserve(small.size());
+  const T *s = small.data(), *l = large.data();
+  if (small.size() * detail::kGallopRatio < large.size()) {
+    detail::IntersectGallop(s, s + small.size(), l, l + large.size(), out);
+  } else {
+    detail::IntersectMerge(s, s + small.size(), l, l + large.size(), out);
+  }
+}
+
+/**
+ * out = a ∪ b.
+ */
+template<typename T>
+void set_union(const vector<T> &a, const vector<T> &b, vector<T> &out) {
+  out.clear();
+  out.reserve(a.size() + b.size());
+  const T *pa = a.data(), *pb = b.data();
+  if (a.size() * detail::kGallopRatio < b.size()) {
+    detail::UnionGallop(pa, pa + a.size(), pb, pb + b.size(), out);
+  } else if (b.size() * detail::kGallopRatio < a.size()) {
+    detail::UnionGallop(pb, pb + b.size(), pa, pa + a.size(), out);
+  } else {
+    detail::UnionMerge(pa, pa + a.size(), pb, pb + b.size(), out);
+  }
+}
+
+/**
+ * out = a \ b.
+ */
+template<typename T>
+void set_difference(const vector<T> &a, const vector<T> &b, vector<T> &out) {
+  out.clear();
+  out.reserve(a.size());
+  const T *pa = a.data(), *pb = b.data();
+  if (a.size() * detail::kGallopRatio < b.size()) {
+    detail::DifferenceGallopSmall(pa, pa + a.size(), pb, pb + b.size(), out);
+  } else if (b.size() * detail::kGallopRatio < a.size()) {
+    detail::DifferenceGallopLarge(pa, pa + a.size(), pb, pb + b.size(), out);
+  } else {
+    detail::DifferenceMerge(pa, pa + a.size(), pb, pb + b.size(), out);
+  }
+}
+
+/**
+ * out = in without repeated neighbours; for sorted input, the set of its values.
+ */
+template<typename T>
+void unique(const vector<T> &in, vector<T> &out) {
+  out.clear();
+  if (in.empty()) {
+    return;
+  }
+  out.reserve(in.size());
+  const T *p = in.data(), *end = p + in.size();
+  out.push_back(*p);
+  for (++p; p != end; ++p) {
+    if (p[-1] < *p || *p < p[-1]) {
+      out.push_back(*p);
+    }
+  }
+}
+
+/**
+ * out = the sorted concatenation of count sorted lists, duplicates kept.
+ * The heads of the lists are kept in a binary min-heap, O(n log count).
+ */
+template<typename T>
+void merge(const vector<T> *lists, size_t count, vector<T> &out) {
+  out.clear();
+  size_t total = 0;
+  for (size_t i = 0; i < count; ++i) {
+    total += lists[i].size();
+  }
+  out.reserve(total);
+  struct cursor {
+    const T *cur, *end;
+  };
+  // owned by a vector, so that it is freed when a copy or comparison throws
+  vector<cursor> storage(count + 1, cursor{nullptr, nullptr});
+  cursor *heap = storage.data();
+  size_t size = 0;
+  auto less = [&heap](size_t i, size_t j) {
+    return *heap[i].cur < *heap[j].cur;
+  };
+  auto sift_down = [&heap, &size, &less](size_t pos) {
+    cursor tmp = heap[pos];
+    heap[size] = tmp; // sentinel slot used for comparisons with tmp
+    while (pos * 2 + 1 < size) {
+      size_t child = pos * 2 + 1;
+      if (child + 1 < size && less(child + 1, child)) {
+        ++child;
+      }
+      if (!less(child, size)) {
+        break;
+      }
+      heap[pos] = heap[child];
+      pos = child;
+    }
+    heap[pos] = tmp;
+  };
+  for (size_t i = 0; i < count; ++i) {
+    if (!lists[i].empty()) {
+      heap[size].cur = lists[i].data();
+      heap[size].end = lists[i].data() + lists[i].size();
+      ++size;
+    }
+  }
+  for (size_t i = size / 2; i-- > 0;) {
+    sift_down(i);
+  }
+  while (size > 1) {
+    out.push_back(*heap[0].cur);
+    if (++heap[0].cur == heap[0].end) {
+      heap[0] = heap[--size];
+    }
+    sift_down(0);
+  }
+  if (size == 1) {
+    for (const T *p = heap[0].cur; p != heap[0].end; ++p) {
+      out.push_back(*p);
+    }
+  }
+}
+template<typename T>
+void merge(const vector<vector<T>> &lists, vector<T> &out) {
+  merge(lists.data(), lists.size(), out);
+}
+
+}
+
+#endif
@@ -0,0 +1,134 @@
+#ifndef SJTU_SPAN_HPP
+#define SJTU_SPAN_HPP
+
+#include "exceptions.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+#include <type_traits>
+
+namespace sjtu {
+/**
+ * a non-owning view of size() contiguous elements, like std::span.
+ * Copying a span never copies the elements. It is invalidated whenever
+ * the storage it views is reallocated or freed.
+ * Element access is bounds checked in the same way as sjtu::vector.
+ */
+template<typename T>
+class span {
+public:
+  using element_type = T;
+  using value_type = std::remove_cv_t<T>;
+  using iterator = T*;
+
+  span() : data_(nullptr), size_(0) {}
+  span(T *data, size_t size) : data_(data), size_(size) {}
+  /**
+   * a template, so that span(p, 0) takes 0 as a size instead of being ambiguous.
+   */
+  template<typename P, typename = std::enable_if_t<std::is_convertible_v<P, T *>>>
+  span(T *first, P last) : data_(first), size_(static_cast<T *>(last) - first) {}
+  /**
+   * views the whole vector.
+   */
+  span(vector<value_type> &v) : data_(v.data()), size_(v.size()) {}
+  template<typename U = T, typename = std::enable_if_t<std::is_const_v<U>>>
+  span(const vector<value_type> &v) : data_(v.data()), size_(v.size()) {}
+  /**
+   * span<T> converts to span<const T>.
+   */
+  template<typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+  span(const span<U> &other) : data_(other.data()), size_(other.size()) {}
+
+  /**
+   * access specified element with bounds checking.
+   * throw index_out_of_bound if pos is not in [0, size)
+   */
+  T &operator [] (const size_t &pos) const {
+    if (pos >= size_) {
+      throw index_out_of_bound();
+    }
+    return data_[pos];
+  }
+  T &at(const size_t &pos) const {
+    return (*this)[pos];
+  }
+  /**
+   * throw container_is_empty if size == 0
+   */
+  T &front() const {
+    if (size_ == 0) {
+      throw container_is_empty();
+    }
+    return data_[0];
+  }
+  T &back() const {
+    if (size_ == 0) {
+      throw container_is_empty();
+    }
+    return data_[size_ - 1];
+  }
+  T *data() const {
+    return data_;
+  }
+  iterator begin() const {
+    return data_;
+  }
+  iterator end() const {
+    return data_ + size_;
+  }
+  size_t size() const {
+    return size_;
+  }
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  /**
+   * the first count elements.
+   * throw index_out_of_bound if count > size
+   */
+  span first(const size_t &count) const {
+    if (count > size_) {
+      throw index_out_of_bound();
+    }
+    return span(data_, count);
+  }
+  /**
+   * the last count elements.
+   * throw index_out_of_bound if count > size
+   */
+  span last(const size_t &count) const {
+    if (count > size_) {
+      throw index_out_of_bound();
+    }
+    return span(data_ + (size_ - count), count);
+  }
+  /**
+   * count elements starting at offset, or everything from offset on if count is omitted.
+   * throw index_out_of_bound if [offset, offset + count) is not inside [0, size]
+   */
+  span subspan(const size_t &offset, const size_t &count) const {
+    if (offset > size_ || count > size_ - offset) {
+      throw index_out_of_bound();
+    }
+    return span(data_ + offset, count);
+  }
+  span subspan(const size_t &offset) const {
+    if (offset > size_) {
+      throw index_out_of_bound();
+    }
+    return span(data_ + offset, size_ - offset);
+  }
+
+private:
+  T *data_;
+  size_t size_;
+};
+
+template<typename T>
+using const_span = span<const T>;
+
+}
+
+#endif
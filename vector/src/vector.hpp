@@ -7,11 +7,17 @@
 
 #include <climits>
 #include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
 
 namespace sjtu {
 /**
  * a data container like std::vector
  * store data in a successive memory and support random access.
+ * Every member is constexpr, so a vector can be built and used during constant
+ * evaluation as long as it is freed again before the evaluation ends.
  */
 template<typename T>
 class vector {
@@ -47,74 +53,74 @@ public:
     T *begin_, *ptr_;
   public:
     iterator() = delete;
-    iterator(T *begin, T *ptr) : begin_(begin), ptr_(ptr) {}
-    iterator(const iterator &rhs) : begin_(rhs.begin_), ptr_(rhs.ptr_) {}
+    constexpr iterator(T *begin, T *ptr) : begin_(begin), ptr_(ptr) {}
+    constexpr iterator(const iterator &rhs) : begin_(rhs.begin_), ptr_(rhs.ptr_) {}
     /**
       * return a new iterator which pointer n-next elements
       * as well as operator-
       */
-    iterator operator + (const int &n) const {
+    constexpr iterator operator + (const int &n) const {
       return iterator(begin_, ptr_ + n);
     }
-    iterator operator - (const int &n) const {
+    constexpr iterator operator - (const int &n) const {
       return iterator(begin_, ptr_ - n);
     }
     // return the distance between two iterators,
     // if these two iterators point to different vectors, throw invaild_iterator.
-    int operator - (const iterator &rhs) const {
+    constexpr int operator - (const iterator &rhs) const {
       if (begin_ != rhs.begin_) {
         throw invalid_iterator();
       }
       return ptr_ - rhs.ptr_;
     }
 
-    iterator& operator += (const int &n) {
+    constexpr iterator& operator += (const int &n) {
       ptr_ += n;
       return *this;
     }
-    iterator& operator -= (const int &n) {
+    constexpr iterator& operator -= (const int &n) {
       ptr_ -= n;
       return *this;
     }
 
-    iterator operator ++ (int) {
+    constexpr iterator operator ++ (int) {
       auto tmp = *this;
       ++ptr_;
       return tmp;
     }
-    iterator& operator ++ () {
+    constexpr iterator& operator ++ () {
       ++ptr_;
       return *this;
     }
-    iterator operator -- (int) {
+    constexpr iterator operator -- (int) {
       auto tmp = *this;
       --ptr_;
       return tmp;
     }
-    iterator& operator -- () {
+    constexpr iterator& operator -- () {
       --ptr_;
       return *this;
     }
 
-    T& operator * () const{
+    constexpr T& operator * () const {
       return *ptr_;
     }
     /**
       * a operator to check whether two iterators are same (pointing to the same memory address).
       */
-    bool operator == (const iterator &rhs) const {
+    constexpr bool operator == (const iterator &rhs) const {
       return ptr_ == rhs.ptr_;
     }
-    bool operator == (const const_iterator &rhs) const {
+    constexpr bool operator == (const const_iterator &rhs) const {
       return ptr_ == rhs.ptr_;
     }
     /**
       * some other operator for iterator.
       */
-    bool operator != (const iterator &rhs) const {
+    constexpr bool operator != (const iterator &rhs) const {
       return ptr_ != rhs.ptr_;
     }
-    bool operator != (const const_iterator &rhs) const {
+    constexpr bool operator != (const const_iterator &rhs) const {
       return ptr_ != rhs.ptr_;
     }
   };
@@ -132,115 +138,142 @@ public:
     const T *begin_, *ptr_;
   public:
     const_iterator() = delete;
-    const_iterator(T *begin, T *ptr) : begin_(begin), ptr_(ptr) {}
-    const_iterator(const const_iterator &rhs) : begin_(rhs.begin_), ptr_(rhs.ptr_) {}
+    constexpr const_iterator(T *begin, T *ptr) : begin_(begin), ptr_(ptr) {}
+    constexpr const_iterator(const const_iterator &rhs) : begin_(rhs.begin_), ptr_(rhs.ptr_) {}
 
-    const_iterator operator + (const int &n) const {
+    constexpr const_iterator operator + (const int &n) const {
       return const_iterator(begin_, ptr_ + n);
     }
-    const_iterator operator - (const int &n) const {
+    constexpr const_iterator operator - (const int &n) const {
       return const_iterator(begin_, ptr_ - n);
     }
 
-    int operator - (const const_iterator &rhs) const {
+    constexpr int operator - (const const_iterator &rhs) const {
       if (begin_ != rhs.begin_) {
         throw invalid_iterator();
       }
       return ptr_ - rhs.ptr_;
     }
 
-    const_iterator& operator += (const int &n) {
+    constexpr const_iterator& operator += (const int &n) {
       ptr_ += n;
       return *this;
     }
-    const_iterator& operator -= (const int &n) {
+    constexpr const_iterator& operator -= (const int &n) {
       ptr_ -= n;
       return *this;
     }
 
-    const_iterator operator ++ (int) {
+    constexpr const_iterator operator ++ (int) {
       auto tmp = *this;
       ++ptr_;
       return tmp;
     }
-    const_iterator& operator ++ () {
+    constexpr const_iterator& operator ++ () {
       ++ptr_;
       return *this;
     }
-    const_iterator operator -- (int) {
+    constexpr const_iterator operator -- (int) {
       auto tmp = *this;
       --ptr_;
       return tmp;
     }
-    const_iterator& operator -- () {
+    constexpr const_iterator& operator -- () {
       --ptr_;
       return *this;
     }
 
-    const T operator * () const {
+    constexpr const T operator * () const {
       return *ptr_;
     }
     
-    bool operator == (const iterator &rhs) const {
+    constexpr bool operator == (const iterator &rhs) const {
       return ptr_ == rhs.ptr_;
     }
-    bool operator == (const const_iterator &rhs) const {
+    constexpr bool operator == (const const_iterator &rhs) const {
       return ptr_ == rhs.ptr_;
     }
-    bool operator != (const iterator &rhs) const {
+    constexpr bool operator != (const iterator &rhs) const {
       return ptr_ != rhs.ptr_;
     }
-    bool operator != (const const_iterator &rhs) const {
+    constexpr bool operator != (const const_iterator &rhs) const {
       return ptr_ != rhs.ptr_;
     }
   };
-  vector() {
-    size_ = 0;
-    capacity_ = 3;
-    array_ = static_cast<T *>(operator new [] (capacity_ * sizeof(T)));
+  /**
+    * an empty vector does not allocate.
+    */
+  constexpr vector() : size_(0), capacity_(0), array_(nullptr) {}
+  /**
+    * the constructors below allocate once, exactly for the elements they store.
+    */
+  constexpr vector(const vector &other) : vector() {
+    AssignN(other.array_, other.size_);
   }
-  vector(const vector &other) {
-    size_ = other.size_;
-    capacity_ = other.capacity_;
-    array_ = static_cast<T *>(operator new [] (capacity_ * sizeof(T)));
-    for (size_t i = 0; i < size_; ++i) {
-      new(&array_[i]) T(other.array_[i]);
-    }
+  constexpr vector(std::initializer_list<T> init) : vector() {
+    AssignN(init.begin(), init.size());
   }
-  ~vector() {
+  constexpr vector(const size_t &count, const T &value) : vector() {
+    AssignN(RepeatIterator(&value), count);
+  }
+  template<typename ForwardIt, typename = decltype(*std::declval<ForwardIt &>())>
+  constexpr vector(ForwardIt first, ForwardIt last) : vector() {
+    assign(first, last);
+  }
+  constexpr ~vector() {
     for (size_t i = 0; i < size_; ++i) {
-      array_[i].~T();
+      std::destroy_at(&array_[i]);
     }
-    operator delete [] (array_);
+    Deallocate(array_, capacity_);
   }
-  
-  vector &operator = (const vector &other) {
+
+  /**
+    * reuses the existing buffer when it is large enough:
+    * live elements are copy-assigned and only the difference is constructed or destroyed.
+    */
+  constexpr vector &operator = (const vector &other) {
     if (this == &other) {
       return *this;
     }
-    for (size_t i = 0; i < size_; ++i) {
-      array_[i].~T();
-    }
-    operator delete [] (array_);
-    size_ = other.size_;
-    capacity_ = other.capacity_;
-    array_ = static_cast<T *>(operator new [] (capacity_ * sizeof(T)));;
-    for (size_t i = 0; i < size_; ++i) {
-      new(&array_[i]) T(other.array_[i]);
-    }
+    AssignN(other.array_, other.size_);
     return *this;
   }
+  /**
+    * replaces the contents with count copies of value.
+    */
+  constexpr void assign(const size_t &count, const T &value) {
+    AssignN(RepeatIterator(&value), count);
+  }
+  /**
+    * replaces the contents with the elements in [first, last).
+    */
+  template<typename ForwardIt, typename = decltype(*std::declval<ForwardIt &>())>
+  constexpr void assign(ForwardIt first, ForwardIt last) {
+    size_t count = 0;
+    for (ForwardIt it = first; it != last; ++it) {
+      ++count;
+    }
+    AssignN(first, count);
+  }
+  /**
+    * exchanges the contents with other in O(1), no element is copied.
+    */
+  constexpr void swap(vector &other) {
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(array_, other.array_);
+  }
   /**
     * assigns specified element with bounds checking
     * throw index_out_of_bound if pos is not in [0, size)
     */
-  T &at(const size_t &pos) {
+  constexpr T &at(const size_t &pos) {
     if (pos >= size_) {
       throw index_out_of_bound();
     }
     return array_[pos];
   }
-  const T &at(const size_t &pos) const {
+  constexpr const T &at(const size_t &pos) const {
     if (pos >= size_) {
       throw index_out_of_bound();
     }
@@ -252,13 +285,13 @@ public:
     * !!! Pay attentions
     *   In STL this operator does not check the boundary but I want you to do.
     */
-  T &operator [] (const size_t &pos) {
+  constexpr T &operator [] (const size_t &pos) {
     if (pos >= size_) {
       throw index_out_of_bound();
     }
     return array_[pos];
   }
-  const T &operator [] (const size_t &pos) const {
+  constexpr const T &operator [] (const size_t &pos) const {
     if (pos >= size_) {
       throw index_out_of_bound();
     }
@@ -268,7 +301,7 @@ public:
     * access the first element.
     * throw container_is_empty if size == 0
     */
-  const T &front() const {
+  constexpr const T &front() const {
     if (size_ == 0) {
       throw container_is_empty();
     }
@@ -278,7 +311,7 @@ public:
     * access the last element.
     * throw container_is_empty if size == 0
     */
-  const T &back() const {
+  constexpr const T &back() const {
     if (size_ == 0) {
       throw container_is_empty();
     }
@@ -287,56 +320,76 @@ public:
   /**
     * returns an iterator to the beginning.
     */
-  iterator begin() {
+  constexpr iterator begin() {
     return iterator(array_, array_);
   }
-  const_iterator begin() const {
+  constexpr const_iterator begin() const {
     return const_iterator(array_, array_);
   }
-  const_iterator cbegin() const {
+  constexpr const_iterator cbegin() const {
     return const_iterator(array_, array_);
   }
   /**
     * returns an iterator to the end.
     */
-  iterator end() {
+  constexpr iterator end() {
     return iterator(array_, array_ + size_);
   }
-  const_iterator end() const {
+  constexpr const_iterator end() const {
     return const_iterator(array_, array_ + size_);
   }
-  const_iterator cend() const {
+  constexpr const_iterator cend() const {
     return const_iterator(array_, array_ + size_);
   }
+  /**
+    * returns a pointer to the underlying contiguous storage.
+    */
+  constexpr T *data() {
+    return array_;
+  }
+  constexpr const T *data() const {
+    return array_;
+  }
   /**
     * checks whether the container is empty
     */
-  bool empty() const {
+  constexpr bool empty() const {
     return size_ == 0;
   }
   /**
     * returns the number of elements
     */
-  size_t size() const {
+  constexpr size_t size() const {
     return size_;
   }
   /**
-    * clears the contents
+    * returns the number of elements that fit without reallocating
+    */
+  constexpr size_t capacity() const {
+    return capacity_;
+  }
+  /**
+    * makes room for n elements so that pushing up to n elements does not reallocate.
     */
-  void clear() {
-    capacity_ = 3;
+  constexpr void reserve(const size_t &n) {
+    if (n > capacity_) {
+      Adjust(n);
+    }
+  }
+  /**
+    * clears the contents, the buffer is kept for reuse.
+    */
+  constexpr void clear() {
     for (size_t i = 0; i < size_; ++i) {
-      array_[i].~T();
+      std::destroy_at(&array_[i]);
     }
     size_ = 0;
-    operator delete [] (array_);
-    array_ = static_cast<T *>(operator new [] (capacity_ * sizeof(T)));
   }
   /**
     * inserts value before pos
     * returns an iterator pointing to the inserted value.
     */
-  iterator insert(iterator pos, const T &value) {
+  constexpr iterator insert(iterator pos, const T &value) {
     return insert(pos - begin(), value);
   }
   /**
@@ -345,19 +398,33 @@ public:
     * returns an iterator pointing to the inserted value.
     * throw index_out_of_bound if ind > size (in this situation ind can be size because after inserting the size will increase 1.)
     */
-  iterator insert(const size_t &ind, const T &value) {
+  constexpr iterator insert(const size_t &ind, const T &value) {
     if (ind > size_) {
       throw index_out_of_bound();
     }
+    if (size_ == capacity_) {
+      GrowAndInsert(ind, value);
+      return iterator(array_, array_ + ind);
+    }
+    if (Contains(value)) { // value would be shifted away
+      T tmp(value);
+      return insert(ind, tmp);
+    }
+    // elements are shifted by construction and destruction, so T needs no assignment
     for (size_t i = size_; i > ind; --i) {
-      new(&array_[i]) T(array_[i - 1]);
-      array_[i - 1].~T();
+      std::construct_at(&array_[i], std::move(array_[i - 1]));
+      std::destroy_at(&array_[i - 1]);
+    }
+    try {
+      std::construct_at(&array_[ind], value);
+    } catch (...) {
+      for (size_t i = ind; i < size_; ++i) {
+        std::construct_at(&array_[i], std::move(array_[i + 1]));
+        std::destroy_at(&array_[i + 1]);
+      }
+      throw;
     }
-    new(&array_[ind]) T(value);
     ++size_;
-    if (size_ == capacity_) {
-      DoubleCapacity();
-    } 
     return iterator(array_, array_ + ind);
   }
   /**
@@ -365,7 +432,7 @@ public:
     * return an iterator pointing to the following element.
     * If the iterator pos refers the last element, the end() iterator is returned.
     */
-  iterator erase(iterator pos) {
+  constexpr iterator erase(iterator pos) {
     return erase(pos - begin());
   }
   /**
@@ -373,19 +440,71 @@ public:
     * return an iterator pointing to the following element.
     * throw index_out_of_bound if ind >= size
     */
-  iterator erase(const size_t &ind) {
+  constexpr iterator erase(const size_t &ind) {
     if (ind >= size_) {
       throw index_out_of_bound();
     }
-    if (size_ == 1) {
-      clear();
-      return end();
+    for (size_t i = ind; i + 1 < size_; ++i) {
+      std::destroy_at(&array_[i]);
+      std::construct_at(&array_[i], std::move(array_[i + 1]));
     }
-    for (size_t i = ind; i < size_; ++i) {
-      array_[i].~T();
-      new(&array_[i]) T(array_[i + 1]);
+    std::destroy_at(&array_[--size_]);
+    if (size_ * 3 <= capacity_) {
+      ShrinkCapacity();
     }
-    array_[size_--].~T();
+    return iterator(array_, array_ + ind);
+  }
+  /**
+    * removes all elements for which pred returns true, keeping the order of the others.
+    * Elements are compacted in a single pass and the buffer is shrunk at most once.
+    * returns the number of removed elements.
+    */
+  template<typename Pred>
+  constexpr size_t erase_if(Pred pred) {
+    size_t kept = 0;
+    while (kept < size_ && !pred(array_[kept])) {
+      ++kept;
+    }
+    for (size_t i = kept; i < size_; ++i) {
+      if (!pred(array_[i])) {
+        array_[kept++] = std::move(array_[i]);
+      }
+    }
+    size_t removed = size_ - kept;
+    for (size_t i = kept; i < size_; ++i) {
+      std::destroy_at(&array_[i]);
+    }
+    size_ = kept;
+    if (removed != 0 && size_ * 3 <= capacity_) {
+      ShrinkCapacity();
+    }
+    return removed;
+  }
+  /**
+    * removes all elements equal to value, see erase_if.
+    * returns the number of removed elements.
+    */
+  constexpr size_t remove(const T &value) {
+    if (Contains(value)) { // value would be overwritten during compaction
+      T tmp(value);
+      return remove(tmp);
+    }
+    return erase_if([&value](const T &x) { return x == value; });
+  }
+  /**
+    * removes the element with index ind in O(1) by moving the last element into its place,
+    * so the order of the elements is not kept.
+    * returns an iterator pointing to the element now at index ind.
+    * throw index_out_of_bound if ind >= size
+    */
+  constexpr iterator swap_remove(const size_t &ind) {
+    if (ind >= size_) {
+      throw index_out_of_bound();
+    }
+    if (ind + 1 != size_) {
+      array_[ind] = std::move(array_[size_ - 1]);
+    }
+    std::destroy_at(&array_[--size_]);
     if (size_ * 3 <= capacity_) {
       ShrinkCapacity();
     }
@@ -394,22 +513,23 @@ public:
   /**
     * adds an element to the end.
     */
-  void push_back(const T &value) {
-    new(&array_[size_++]) T(value);
+  constexpr void push_back(const T &value) {
     if (size_ == capacity_) {
-      DoubleCapacity();
+      GrowAndInsert(size_, value);
+      return;
     }
+    std::construct_at(&array_[size_++], value);
   }
   /**
     * remove the last element from the end.
     * throw container_is_empty if size() == 0
     */
-  void pop_back() {
-    if (size_ == 1) {
-      return clear();
+  constexpr void pop_back() {
+    if (size_ == 0) {
+      throw container_is_empty();
     }
     --size_;
-    array_[size_].~T();
+    std::destroy_at(&array_[size_]);
     if (size_ * 3 <= capacity_) {
       ShrinkCapacity();
     }
@@ -418,24 +538,132 @@ public:
 private:
   size_t size_, capacity_;
   T *array_;
-  void Adjust(size_t new_capacity) {
-    capacity_ = new_capacity;
-    T *new_array = static_cast<T *>(operator new [] (capacity_ * sizeof(T)));;
+  // yields the same value forever, used by assign(count, value)
+  class RepeatIterator {
+  private:
+    const T *value_;
+  public:
+    constexpr explicit RepeatIterator(const T *value) : value_(value) {}
+    constexpr const T &operator * () const {
+      return *value_;
+    }
+    constexpr RepeatIterator &operator ++ () {
+      return *this;
+    }
+  };
+  /**
+    * std::allocator instead of operator new[] and placement new, because only
+    * the former can be used during constant evaluation.
+    */
+  static constexpr T *Allocate(size_t n) {
+    return std::allocator<T>().allocate(n);
+  }
+  static constexpr void Deallocate(T *p, size_t n) {
+    if (p != nullptr) {
+      std::allocator<T>().deallocate(p, n);
+    }
+  }
+  // whether value lives in [array_, array_ + size_); pointers into different
+  // objects cannot be ordered at compile time, so there it compares one by one
+  constexpr bool Contains(const T &value) const {
+    if (std::is_constant_evaluated()) {
+      for (size_t i = 0; i < size_; ++i) {
+        if (&value == &array_[i]) {
+          return true;
+        }
+      }
+      return false;
+    }
+    return &value >= array_ && &value < array_ + size_;
+  }
+  template<typename InputIt>
+  constexpr void AssignN(InputIt first, size_t count) {
+    if (count > capacity_) {
+      size_t new_capacity = count;
+      T *new_array = Allocate(new_capacity);
+      size_t built = 0;
+      try {
+        for (; built < count; ++built, ++first) {
+          std::construct_at(&new_array[built], *first);
+        }
+      } catch (...) {
+        while (built > 0) {
+          std::destroy_at(&new_array[--built]);
+        }
+        Deallocate(new_array, new_capacity);
+        throw;
+      }
+      for (size_t i = 0; i < size_; ++i) {
+        std::destroy_at(&array_[i]);
+      }
+      Deallocate(array_, capacity_);
+      array_ = new_array;
+      capacity_ = new_capacity;
+      size_ = count;
+      return;
+    }
+    size_t i = 0;
+    for (; i < size_ && i < count; ++i, ++first) {
+      array_[i] = *first;
+    }
+    // counted as soon as each is built, so that a throwing copy leaks nothing
+    for (; i < count; ++i, ++first) {
+      std::construct_at(&array_[i], *first);
+      size_ = i + 1;
+    }
+    for (; i < size_; ++i) {
+      std::destroy_at(&array_[i]);
+    }
+    size_ = count;
+  }
+  constexpr void Adjust(size_t new_capacity) {
+    T *new_array = nullptr;
+    if (new_capacity != 0) {
+      new_array = Allocate(new_capacity);
+    }
     for (size_t i = 0; i < size_; ++i) {
-      new(&new_array[i]) T(array_[i]);
-      array_[i].~T();
+      std::construct_at(&new_array[i], std::move(array_[i]));
+      std::destroy_at(&array_[i]);
     }
-    operator delete [] (array_);
+    Deallocate(array_, capacity_);
     array_ = new_array;
+    capacity_ = new_capacity;
   }
-  void DoubleCapacity() {
-    Adjust(size_ * 2);
+  /**
+    * doubles the capacity and puts a copy of value at index ind.
+    * The copy is made before the old buffer goes away, so value may be an element.
+    */
+  constexpr void GrowAndInsert(size_t ind, const T &value) {
+    size_t new_capacity = capacity_ == 0 ? 4 : capacity_ * 2;
+    T *new_array = Allocate(new_capacity);
+    try {
+      std::construct_at(&new_array[ind], value);
+    } catch (...) {
+      Deallocate(new_array, new_capacity);
+      throw;
+    }
+    for (size_t i = 0; i < size_; ++i) {
+      std::construct_at(&new_array[i < ind ? i : i + 1], std::move(array_[i]));
+      std::destroy_at(&array_[i]);
+    }
+    Deallocate(array_, capacity_);
+    array_ = new_array;
+    capacity_ = new_capacity;
+    ++size_;
   }
-  void ShrinkCapacity() {
-    Adjust((capacity_ + 2) / 3 * 2);
+  constexpr void ShrinkCapacity() {
+    size_t new_capacity = size_ == 0 ? 0 : (capacity_ + 2) / 3 * 2;
+    if (new_capacity < capacity_) {
+      Adjust(new_capacity);
+    }
   }
 };
 
+template<typename T>
+constexpr void swap(vector<T> &lhs, vector<T> &rhs) {
+  lhs.swap(rhs);
+}
+
 }
 
 #endif
\ No newline at end of file